@@ -0,0 +1,134 @@
+/**
+ * @file AcquisitionStats.h
+ * @brief Estadísticas de adquisición de la célula de carga: tasa efectiva, jitter y pérdidas.
+ *
+ * Se alimenta desde la tarea de adquisición con la marca de tiempo de cada conversión
+ * y los ciclos de CPU que costó leerla. Con ello:
+ *   - mide el intervalo entre muestras (mín / máx / p99 mediante histograma),
+ *   - deduce la tasa nominal (p.ej. si el pin RATE del HX711 está a 10 o 80 SPS),
+ *   - cuenta conversiones perdidas (intervalos de ~2x, 3x... el nominal),
+ *   - acumula el tiempo pasado leyendo el chip (sección crítica en el backend GPIO).
+ * Aritmética entera y memoria fija; las lecturas desde el otro núcleo son orientativas.
+ */
+#pragma once
+#include <Arduino.h>
+
+class AcquisitionStats {
+public:
+    static constexpr uint16_t BUCKET_US = 500;  ///< Anchura de cada barra del histograma
+    static constexpr uint16_t BUCKETS = 256;    ///< Cubre intervalos de hasta 128 ms (10 SPS = 100 ms)
+
+    /** Pide un reinicio desde otro núcleo; se aplica en el siguiente record(). */
+    void requestReset() { resetRequested = true; }
+
+    /**
+     * @brief Registra una conversión.
+     * @param sampleUs   micros() del instante en que la conversión estuvo lista
+     * @param readCycles ciclos de CPU empleados en leerla
+     */
+    void record(uint32_t sampleUs, uint32_t readCycles) {
+        if (resetRequested) {
+            resetRequested = false;
+            reset();
+        }
+
+        readCyclesSum += readCycles;
+        if (readCycles > readCyclesMax) readCyclesMax = readCycles;
+        samples++;
+
+        if (samples > 1) {
+            const uint32_t interval = sampleUs - lastUs;
+            intervalSum += interval;
+            intervals++;
+            if (interval < intervalMin) intervalMin = interval;
+            if (interval > intervalMax) intervalMax = interval;
+
+            uint32_t b = interval / BUCKET_US;
+            if (b >= BUCKETS) b = BUCKETS - 1;
+            if (histogram[b] < 0xFFFF) histogram[b]++;
+
+            // Intervalos de ~N periodos nominales implican N-1 conversiones perdidas
+            if (nominalUs > 0 && interval > nominalUs + nominalUs / 2) {
+                missedCount += (interval + nominalUs / 2) / nominalUs - 1;
+            }
+
+            // Re-estimar el periodo nominal periódicamente a partir de la mediana
+            if ((intervals & (RECALC_EVERY - 1)) == 0) {
+                nominalUs = 1000000UL / nearestRate(percentileUs(50));
+            }
+        }
+        lastUs = sampleUs;
+    }
+
+    /** Tasa efectiva medida, en centésimas de Hz. */
+    uint32_t effectiveRateCentiHz() const {
+        return intervalSum ? (uint32_t)((uint64_t)intervals * 100000000ULL / intervalSum) : 0;
+    }
+
+    /** Tasa nominal deducida (10/20/40/80/320 SPS), 0 si aún no hay datos suficientes. */
+    uint16_t detectedRate() const { return nominalUs ? (uint16_t)(1000000UL / nominalUs) : 0; }
+
+    uint32_t intervalMinUs() const { return intervals ? intervalMin : 0; }
+    uint32_t intervalMaxUs() const { return intervalMax; }
+
+    /** Percentil p (0-100) del intervalo entre muestras, con resolución BUCKET_US. */
+    uint32_t percentileUs(uint8_t p) const {
+        uint32_t total = 0;
+        for (uint16_t i = 0; i < BUCKETS; i++) total += histogram[i];
+        if (total == 0) return 0;
+        const uint32_t target = (total * p + 99) / 100;
+        uint32_t acc = 0;
+        for (uint16_t i = 0; i < BUCKETS; i++) {
+            acc += histogram[i];
+            if (acc >= target) return (uint32_t)(i + 1) * BUCKET_US;
+        }
+        return (uint32_t)BUCKETS * BUCKET_US;
+    }
+
+    uint32_t missed() const { return missedCount; }
+    uint32_t count() const { return samples; }
+
+    /** Ciclos de CPU de lectura: media y máximo. */
+    uint32_t readCyclesAvg() const { return samples ? (uint32_t)(readCyclesSum / samples) : 0; }
+    uint32_t readCyclesPeak() const { return readCyclesMax; }
+
+private:
+    static constexpr uint16_t RECALC_EVERY = 64; // Potencia de 2
+
+    /** Tasa estándar más cercana a un intervalo dado. */
+    static uint16_t nearestRate(uint32_t intervalUs) {
+        static const uint16_t rates[] = {10, 20, 40, 80, 320};
+        if (intervalUs == 0) return rates[0];
+        const uint32_t hz = 1000000UL / intervalUs;
+        uint16_t best = rates[0];
+        for (uint16_t r : rates) {
+            if (abs((int32_t)hz - r) < abs((int32_t)hz - best)) best = r;
+        }
+        return best;
+    }
+
+    void reset() {
+        samples = 0;
+        intervals = 0;
+        intervalSum = 0;
+        intervalMin = UINT32_MAX;
+        intervalMax = 0;
+        missedCount = 0;
+        readCyclesSum = 0;
+        readCyclesMax = 0;
+        memset(histogram, 0, sizeof(histogram));
+    }
+
+    volatile bool resetRequested = false;
+    uint32_t samples = 0;
+    uint32_t intervals = 0;
+    uint64_t intervalSum = 0;
+    uint32_t intervalMin = UINT32_MAX;
+    uint32_t intervalMax = 0;
+    uint32_t lastUs = 0;
+    uint32_t nominalUs = 0;
+    uint32_t missedCount = 0;
+    uint64_t readCyclesSum = 0;
+    uint32_t readCyclesMax = 0;
+    uint16_t histogram[BUCKETS] = {0};
+};
@@ -0,0 +1,110 @@
+/**
+ * @file AlphaBetaEstimator.h
+ * @brief Estimador alfa-beta (posición + velocidad) para ocultar la latencia de la célula de carga.
+ *
+ * El HX711 entrega 10-80 muestras/s pero el HID se envía mucho más a menudo: entre
+ * conversiones el freno se quedaba quieto y avanzaba a escalones de ~12 ms. El
+ * estimador sigue posición y velocidad con las marcas de tiempo reales de cada
+ * muestra (Kalman de estado estacionario con ganancias fijas alfa y beta) y, en el
+ * instante de publicar, extrapola x + v * (ahora - t_muestra). Así la salida sube
+ * en rampa en lugar de a escalones.
+ *
+ * La extrapolación se limita a un intervalo medio entre muestras (si la célula deja
+ * de responder se mantiene el último valor) y la salida a `overshoot` cuentas de
+ * la última medida, para que al soltar de golpe no se publique un pico que la
+ * siguiente muestra desmienta. Aritmética entera: posición en Q8 y velocidad en
+ * Q24 cuentas/us.
+ */
+#pragma once
+#include <Arduino.h>
+
+class AlphaBetaEstimator {
+public:
+    static constexpr uint8_t GAIN_BITS = 15;  // alfa y beta en Q15
+    static constexpr uint8_t POS_FRAC = 8;    // Bits fraccionarios de la posición
+    static constexpr uint8_t VEL_FRAC = 24;   // Velocidad en cuentas/us, Q24
+    static constexpr uint8_t INTERVAL_SHIFT = 3; // Media del intervalo entre muestras: 2^3 muestras
+    static constexpr uint32_t MAX_DT_US = 200000; // Un hueco mayor reinicia la velocidad
+    static constexpr int32_t MAX_VEL_Q = 1 << 30;  // 64 cuentas/us: muy por encima de cualquier pisotón
+
+    /**
+     * @brief Configura el estimador.
+     * @param alphaQ15  Ganancia de posición (0..32768 = 0..1).
+     * @param betaQ15   Ganancia de velocidad (0..32768 = 0..1, por muestra; típico 0.05-0.3).
+     * @param overshoot Máximo que la salida puede alejarse de la última medida (cuentas).
+     * @param fullScale Fondo de escala de la salida.
+     */
+    void configure(uint16_t alphaQ15, uint16_t betaQ15, int32_t overshoot, int32_t fullScale) {
+        alpha = alphaQ15;
+        beta = betaQ15;
+        maxOvershoot = overshoot > 0 ? overshoot : 0;
+        scale = fullScale;
+    }
+
+    /** Incorpora una muestra medida en `sampleUs` (micros() del dato listo). */
+    void update(int32_t z, uint32_t sampleUs) {
+        const int32_t zQ = z << POS_FRAC;
+        lastZ = z;
+        if (!primed) {
+            primed = true;
+            posQ = zQ;
+            velQ = 0;
+            lastUs = sampleUs;
+            intervalUs = 0;
+            return;
+        }
+        const uint32_t dt = sampleUs - lastUs;
+        lastUs = sampleUs;
+        if (dt == 0) return;
+        if (dt > MAX_DT_US) {
+            posQ = zQ; // Hueco largo: la velocidad ya no dice nada
+            velQ = 0;
+            return;
+        }
+        intervalUs = intervalUs ? intervalUs + (((int32_t)dt - (int32_t)intervalUs) >> INTERVAL_SHIFT) : dt;
+
+        // Predicción a la hora de la muestra y corrección con el residuo
+        const int32_t predQ = posQ + (int32_t)(((int64_t)velQ * dt) >> (VEL_FRAC - POS_FRAC));
+        const int32_t r = zQ - predQ;
+        posQ = predQ + (int32_t)(((int64_t)r * alpha) >> GAIN_BITS);
+        int64_t v = velQ + (((((int64_t)r * beta) >> GAIN_BITS) << (VEL_FRAC - POS_FRAC)) / (int64_t)dt);
+        if (v > MAX_VEL_Q) v = MAX_VEL_Q;
+        if (v < -MAX_VEL_Q) v = -MAX_VEL_Q;
+        velQ = (int32_t)v;
+    }
+
+    /** Estimación compensada para el instante `nowUs`, recortada a 0..fullScale. */
+    int32_t estimate(uint32_t nowUs) const {
+        int32_t pos = posQ;
+        uint32_t lead = nowUs - lastUs;
+        if (intervalUs && lead <= 4 * intervalUs) { // Más allá, la célula no responde: no extrapolar
+            if (lead > intervalUs) lead = intervalUs;
+            pos += (int32_t)(((int64_t)velQ * lead) >> (VEL_FRAC - POS_FRAC));
+        }
+        int32_t out = (pos + (1 << (POS_FRAC - 1))) >> POS_FRAC;
+        // Nunca más de `overshoot` cuentas más allá de la última medida
+        if (out > lastZ + maxOvershoot) out = lastZ + maxOvershoot;
+        if (out < lastZ - maxOvershoot) out = lastZ - maxOvershoot;
+        if (out < 0) out = 0;
+        if (out > scale) out = scale;
+        return out;
+    }
+
+    /** Velocidad estimada en cuentas/s (diagnóstico). */
+    int32_t velocity() const { return (int32_t)(((int64_t)velQ * 1000000) >> VEL_FRAC); }
+
+    /** Intervalo medio entre muestras en us (diagnóstico). */
+    uint32_t interval() const { return intervalUs; }
+
+private:
+    uint16_t alpha = 1 << GAIN_BITS;
+    uint16_t beta = 0;
+    int32_t maxOvershoot = 0;
+    int32_t scale = 0;
+    int32_t posQ = 0;      // Q8
+    int32_t velQ = 0;      // Q24 cuentas/us
+    int32_t lastZ = 0;     // Última medida
+    uint32_t lastUs = 0;
+    uint32_t intervalUs = 0;
+    bool primed = false;
+};
@@ -0,0 +1,335 @@
+/*
+ *  Project     Sim Racing Library for Arduino
+ *  @author     David Madison
+ *  @link       github.com/dmadison/Sim-Racing-Arduino
+ *  @license    LGPLv3 - Copyright (c) 2022 David Madison
+ *
+ *  This file is part of the Sim Racing Library for Arduino.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AnalogDMA.h"
+#include "SimRacing.h"
+
+/**
+* @file AnalogDMA.cpp
+* @brief Source file for the continuous (DMA) ADC sampling backend
+*/
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "soc/soc_caps.h"
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32) && SOC_ADC_DMA_SUPPORTED
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali_scheme.h"
+#define SIM_RACING_ADC_DMA 1
+#endif
+
+namespace SimRacing {
+
+#if defined(SIM_RACING_ADC_DMA)
+
+static const uint32_t FrameBytes = 256;  ///< bytes per DMA conversion frame
+static const uint32_t PoolBytes = 1024;  ///< bytes buffered by the driver between polls
+static const uint8_t NoChannel = 0xFF;   ///< marker for ADC channels that aren't scanned
+static const uint16_t CodeMax = (1 << SOC_ADC_DIGI_MAX_BITWIDTH) - 1;  ///< largest raw conversion
+
+/**
+* @brief Running boxcar average for one scanned channel
+*/
+struct ChannelState {
+	int16_t pin;                                     ///< pin number, Arduino numbering
+	uint8_t channel;                                 ///< ADC1 channel number for the pin
+	uint8_t index;                                   ///< next slot to overwrite in the history
+	uint8_t filled;                                  ///< number of valid slots in the history
+	uint16_t history[1 << ContinuousADC::MaxOversamplingLog2];  ///< most recent raw conversions
+	uint32_t sum;                                    ///< sum of the valid history slots
+	uint16_t* linear;                                ///< raw code to corrected code table, null if disabled
+	SpikeRejector spikes;                            ///< median-of-3 ahead of decimation
+};
+
+static adc_continuous_handle_t handle = nullptr;                ///< driver handle, null when stopped
+static ChannelState channels[ContinuousADC::MaxChannels];       ///< per-channel decimation state
+static uint8_t numChannels = 0;                                 ///< number of scanned channels
+static uint8_t channelLookup[16];                               ///< ADC channel number to state index
+static uint32_t totalConversions = 0;                           ///< conversions received since begin()
+static uint8_t oversamplingLog2 = ContinuousADC::DefaultOversamplingLog2;  ///< boxcar length, as a power of two
+
+static void clearHistory(ChannelState& state) {
+	memset(state.history, 0, sizeof(state.history));
+	state.index = 0;
+	state.filled = 0;
+	state.sum = 0;
+}
+
+static ChannelState* findChannel(int16_t pin) {
+	for (uint8_t i = 0; i < numChannels; ++i) {
+		if (channels[i].pin == pin) return &channels[i];
+	}
+	return nullptr;
+}
+
+bool ContinuousADC::begin(const int16_t* pins, uint8_t count, uint32_t sampleRate) {
+	end();
+
+	if (count > MaxChannels) count = MaxChannels;
+	if (sampleRate < SOC_ADC_SAMPLE_FREQ_THRES_LOW) sampleRate = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+	if (sampleRate > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) sampleRate = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+
+	memset(channelLookup, NoChannel, sizeof(channelLookup));
+	adc_digi_pattern_config_t pattern[MaxChannels] = {};
+
+	for (uint8_t i = 0; i < count; ++i) {
+		if (pins[i] < 0) continue;
+
+		adc_unit_t unit;
+		adc_channel_t channel;
+		if (adc_continuous_io_to_channel(pins[i], &unit, &channel) != ESP_OK) continue;
+		if (unit != ADC_UNIT_1) continue;  // ADC2 can't be used with DMA on all targets
+		if (channelLookup[channel] != NoChannel) continue;  // duplicate pin
+
+		ChannelState& state = channels[numChannels];
+		clearHistory(state);
+		state.linear = nullptr;
+		state.spikes = SpikeRejector();
+		state.pin = pins[i];
+		state.channel = (uint8_t) channel;
+
+		pattern[numChannels].atten = ADC_ATTEN_DB_12;  // full 0-3.1V span, same as analogRead()
+		pattern[numChannels].channel = (uint8_t) channel;
+		pattern[numChannels].unit = ADC_UNIT_1;
+		pattern[numChannels].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+		channelLookup[channel] = numChannels;
+		++numChannels;
+	}
+
+	if (numChannels == 0) return false;
+
+	adc_continuous_handle_cfg_t handleConfig = {};
+	handleConfig.max_store_buf_size = PoolBytes;
+	handleConfig.conv_frame_size = FrameBytes;
+	handleConfig.flags.flush_pool = 1;  // after a long stall, keep the newest frames rather than the oldest
+	if (adc_continuous_new_handle(&handleConfig, &handle) != ESP_OK) {
+		handle = nullptr;
+		numChannels = 0;
+		return false;
+	}
+
+	adc_continuous_config_t config = {};
+	config.pattern_num = numChannels;
+	config.adc_pattern = pattern;
+	config.sample_freq_hz = sampleRate;
+	config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+	config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+	if (adc_continuous_config(handle, &config) != ESP_OK || adc_continuous_start(handle) != ESP_OK) {
+		adc_continuous_deinit(handle);
+		handle = nullptr;
+		numChannels = 0;
+		return false;
+	}
+
+	totalConversions = 0;
+	return true;
+}
+
+void ContinuousADC::setOversampling(uint8_t log2) {
+	if (log2 > MaxOversamplingLog2) log2 = MaxOversamplingLog2;
+	oversamplingLog2 = log2;
+
+	for (uint8_t i = 0; i < numChannels; ++i) {
+		clearHistory(channels[i]);
+	}
+}
+
+uint8_t ContinuousADC::resolution() {
+	return SOC_ADC_DIGI_MAX_BITWIDTH + oversamplingLog2 / 2;
+}
+
+/**
+* Builds the correction table for one channel from the eFuse calibration
+*
+* The calibrated voltage of each raw code is rescaled so that codes 0 and
+* CodeMax keep their values, which leaves the user's min/max calibration
+* meaningful while straightening the curve in between.
+*
+* @param state the channel to build the table for
+* @return 'true' if the table was built, 'false' otherwise
+*/
+static bool buildLinearization(ChannelState& state) {
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+	adc_cali_handle_t cali = nullptr;
+	adc_cali_curve_fitting_config_t config = {};
+	config.unit_id = ADC_UNIT_1;
+	config.chan = (adc_channel_t) state.channel;
+	config.atten = ADC_ATTEN_DB_12;
+	config.bitwidth = (adc_bitwidth_t) SOC_ADC_DIGI_MAX_BITWIDTH;
+
+	if (adc_cali_create_scheme_curve_fitting(&config, &cali) != ESP_OK) return false;
+
+	int low = 0, high = 0;
+	adc_cali_raw_to_voltage(cali, 0, &low);
+	adc_cali_raw_to_voltage(cali, CodeMax, &high);
+
+	uint16_t* table = nullptr;
+	if (high > low) table = (uint16_t*) malloc((CodeMax + 1) * sizeof(uint16_t));
+
+	if (table != nullptr) {
+		int32_t previous = 0;
+		for (uint32_t raw = 0; raw <= CodeMax; ++raw) {
+			int mv = low;
+			adc_cali_raw_to_voltage(cali, raw, &mv);
+
+			int32_t code = (int32_t)(mv - low) * CodeMax / (high - low);
+			if (code < previous) code = previous;  // stay monotonic, decimation relies on it
+			if (code > CodeMax) code = CodeMax;
+			table[raw] = (uint16_t) code;
+			previous = code;
+		}
+	}
+
+	adc_cali_delete_scheme_curve_fitting(cali);
+
+	if (table == nullptr) return false;
+	state.linear = table;
+	clearHistory(state);  // don't average corrected and uncorrected codes
+	return true;
+#else
+	(void) state;
+	return false;
+#endif
+}
+
+static void freeLinearization(ChannelState& state) {
+	if (state.linear == nullptr) return;
+	free(state.linear);
+	state.linear = nullptr;
+	clearHistory(state);
+}
+
+bool ContinuousADC::setLinearization(bool enable) {
+	if (handle == nullptr) return false;
+
+	bool active = enable;
+	for (uint8_t i = 0; i < numChannels; ++i) {
+		freeLinearization(channels[i]);
+		if (enable && !buildLinearization(channels[i])) active = false;
+	}
+
+	// all or nothing, so every pedal sees the same transfer curve
+	if (!active) {
+		for (uint8_t i = 0; i < numChannels; ++i) freeLinearization(channels[i]);
+	}
+	return active;
+}
+
+void ContinuousADC::setSpikeRejection(int16_t pin, int threshold) {
+	ChannelState* state = findChannel(pin);
+	if (state != nullptr) state->spikes.setThreshold(threshold);
+}
+
+uint32_t ContinuousADC::spikeCount(int16_t pin) {
+	ChannelState* state = findChannel(pin);
+	return state != nullptr ? state->spikes.getCount() : 0;
+}
+
+bool ContinuousADC::linearized() {
+	return handle != nullptr && numChannels > 0 && channels[0].linear != nullptr;
+}
+
+void ContinuousADC::end() {
+	if (handle != nullptr) {
+		adc_continuous_stop(handle);
+		adc_continuous_deinit(handle);
+		handle = nullptr;
+	}
+	for (uint8_t i = 0; i < numChannels; ++i) {
+		freeLinearization(channels[i]);
+	}
+	numChannels = 0;
+}
+
+bool ContinuousADC::handles(int16_t pin) {
+	return handle != nullptr && findChannel(pin) != nullptr;
+}
+
+void ContinuousADC::poll() {
+	if (handle == nullptr) return;
+
+	uint8_t frame[FrameBytes];
+	uint32_t length = 0;
+
+	// non-blocking: drain every complete frame the DMA has queued up
+	while (adc_continuous_read(handle, frame, sizeof(frame), &length, 0) == ESP_OK) {
+		for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+			const adc_digi_output_data_t* result = (const adc_digi_output_data_t*) &frame[i];
+
+			const uint8_t channel = result->type2.channel;
+			if (channel >= sizeof(channelLookup) || channelLookup[channel] == NoChannel) continue;
+
+			ChannelState& state = channels[channelLookup[channel]];
+			const uint16_t raw = result->type2.data;
+			const uint16_t sample = state.spikes.filter(state.linear ? state.linear[raw] : raw);
+
+			state.sum -= state.history[state.index];
+			state.sum += sample;
+			state.history[state.index] = sample;
+			state.index = (state.index + 1) & ((1 << oversamplingLog2) - 1);
+			if (state.filled < (1 << oversamplingLog2)) ++state.filled;
+
+			++totalConversions;
+		}
+	}
+}
+
+bool ContinuousADC::fetch(int16_t pin, int& value) {
+	ChannelState* state = findChannel(pin);
+	if (handle == nullptr || state == nullptr) return false;
+
+	poll();
+	if (state->filled == 0) return false;
+
+	// bit growth: the sum of 2^k samples carries k extra bits, of which
+	// only k/2 are real resolution, the rest is averaged-out noise
+	const uint8_t shift = oversamplingLog2 - oversamplingLog2 / 2;
+	if (state->filled == (1 << oversamplingLog2)) value = state->sum >> shift;
+	else value = ((state->sum << oversamplingLog2) / state->filled) >> shift;  // still warming up
+	return true;
+}
+
+uint32_t ContinuousADC::conversions() {
+	return totalConversions;
+}
+
+#else
+
+bool ContinuousADC::begin(const int16_t*, uint8_t, uint32_t) { return false; }
+void ContinuousADC::setOversampling(uint8_t) {}
+uint8_t ContinuousADC::resolution() { return 0; }
+bool ContinuousADC::setLinearization(bool) { return false; }
+bool ContinuousADC::linearized() { return false; }
+void ContinuousADC::setSpikeRejection(int16_t, int) {}
+uint32_t ContinuousADC::spikeCount(int16_t) { return 0; }
+void ContinuousADC::end() {}
+bool ContinuousADC::handles(int16_t) { return false; }
+bool ContinuousADC::fetch(int16_t, int&) { return false; }
+void ContinuousADC::poll() {}
+uint32_t ContinuousADC::conversions() { return 0; }
+
+#endif
+
+}  // namespace SimRacing
@@ -0,0 +1,188 @@
+/*
+ *  Project     Sim Racing Library for Arduino
+ *  @author     David Madison
+ *  @link       github.com/dmadison/Sim-Racing-Arduino
+ *  @license    LGPLv3 - Copyright (c) 2022 David Madison
+ *
+ *  This file is part of the Sim Racing Library for Arduino.
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIM_RACING_ANALOG_DMA_H
+#define SIM_RACING_ANALOG_DMA_H
+
+#include <Arduino.h>
+
+/**
+* @file AnalogDMA.h
+* @brief Continuous (DMA) ADC sampling backend for analog inputs
+*/
+
+namespace SimRacing {
+	/**
+	* @brief Samples a set of analog pins in the background using the
+	* continuous ADC mode of the ESP32 family
+	*
+	* The ADC scans every registered channel at a fixed rate and writes the
+	* conversions to a DMA ring buffer owned by the driver. Calls to fetch()
+	* drain whatever frames are pending and return the latest decimated
+	* value for the pin, so reading an axis never blocks on a conversion.
+	*
+	* Decimation is a moving boxcar over the last 2^k conversions. Rather
+	* than dividing the sum back down to the converter's width, only k/2
+	* bits are dropped: with uncorrelated noise each 4x of oversampling
+	* buys one effective bit, so 16x on a 12-bit converter reports 14 bits.
+	* The width of the output is available from resolution().
+	*
+	* There is a single ADC engine, so the class is static. While it is
+	* running the scanned pins must not be read with analogRead(), which
+	* would fight the continuous driver for the ADC unit. AnalogInput
+	* handles this transparently.
+	*
+	* On targets without continuous ADC support begin() returns 'false' and
+	* AnalogInput falls back to analogRead().
+	*/
+	class ContinuousADC {
+	public:
+		static const uint8_t MaxChannels = 8;            ///< Maximum number of pins that can be scanned
+		static const uint8_t MaxOversamplingLog2 = 6;    ///< Maximum oversampling ratio, as a power of two (64x)
+		static const uint8_t DefaultOversamplingLog2 = 3;  ///< Oversampling ratio used until configured (8x)
+
+		/**
+		* Starts scanning the given pins
+		*
+		* All pins must belong to ADC unit 1. Pins that are unused or that
+		* cannot be mapped to an ADC1 channel are rejected.
+		*
+		* @param pins        array of pins to scan (Arduino numbering)
+		* @param count       number of pins in the array
+		* @param sampleRate  total conversions per second, shared between
+		*                    all channels
+		*
+		* @return 'true' if the driver is running, 'false' otherwise
+		*/
+		static bool begin(const int16_t* pins, uint8_t count, uint32_t sampleRate = 20000);
+
+		/**
+		* Sets the oversampling ratio used by the decimator
+		*
+		* The per-channel history is cleared, so the next few values are
+		* averaged over fewer conversions until it refills.
+		*
+		* @param log2  oversampling ratio as a power of two, clamped to
+		*              MaxOversamplingLog2 (e.g. 4 for 16x)
+		*/
+		static void setOversampling(uint8_t log2);
+
+		/**
+		* Retrieves the width of the values returned by fetch(), including
+		* the bits gained from oversampling
+		*
+		* @return the output resolution, in bits
+		*/
+		static uint8_t resolution();
+
+		/**
+		* Enables or disables the non-linearity correction table
+		*
+		* The ESP32 ADC transfer curve bends near both rails. When enabled,
+		* a table with one entry per raw code is built for every scanned
+		* channel from the chip's eFuse calibration (curve fitting scheme),
+		* rescaled to the converter's full code range. Each conversion is
+		* then corrected with a single lookup before decimation, with no
+		* floating point work per sample.
+		*
+		* Must be called after begin(), as the tables are per channel.
+		*
+		* @param enable whether to correct the conversions
+		*
+		* @return 'true' if the correction is active on every channel,
+		*         'false' if disabled or the chip has no suitable
+		*         calibration data
+		*/
+		static bool setLinearization(bool enable);
+
+		/**
+		* Checks whether the non-linearity correction is active
+		*
+		* @return 'true' if conversions are being corrected
+		*/
+		static bool linearized();
+
+		/**
+		* Sets the spike rejection threshold for one scanned pin
+		*
+		* Conversions from the pin go through a SpikeRejector (median-of-3)
+		* before decimation. The median spans three consecutive conversions
+		* of the pin, so it only removes excursions of a single conversion
+		* period: sampleRate / channels, 100 us for two pins at 20 kHz.
+		* A dropout of n >= 2 conversions passes the median and is left to
+		* the boxcar, which scales it to n / 2^k of its height for the 2^k
+		* conversions it stays in the history.
+		*
+		* @param pin        the pin to configure
+		* @param threshold  jump, in raw conversion codes, that counts as a
+		*                   spike. 0 disables the stage.
+		*/
+		static void setSpikeRejection(int16_t pin, int threshold);
+
+		/**
+		* Retrieves the number of spikes rejected on a scanned pin
+		*
+		* @param pin the pin to retrieve the count for
+		* @return the spike count, 0 if the pin isn't scanned
+		*/
+		static uint32_t spikeCount(int16_t pin);
+
+		/**
+		* Stops scanning and releases the driver
+		*/
+		static void end();
+
+		/**
+		* Checks whether a pin is being sampled by the continuous driver
+		*
+		* @param pin the pin to check
+		* @return 'true' if the pin is scanned, 'false' otherwise
+		*/
+		static bool handles(int16_t pin);
+
+		/**
+		* Drains pending DMA frames and retrieves the latest decimated value
+		* for a pin
+		*
+		* @param pin    the pin to retrieve the value of
+		* @param value  reference to store the value in, untouched on failure
+		*
+		* @return 'true' if a value is available, 'false' if the pin isn't
+		*         scanned or no conversion has arrived yet
+		*/
+		static bool fetch(int16_t pin, int& value);
+
+		/**
+		* Drains any pending DMA frames into the per-channel averages
+		*/
+		static void poll();
+
+		/**
+		* Retrieves the number of conversions received since begin()
+		*
+		* @return the conversion count, per channel total
+		*/
+		static uint32_t conversions();
+	};
+}
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file AutoZero.h
+ * @brief Tara asíncrona y seguimiento lento de la deriva del cero de una célula de carga.
+ *
+ * Sustituye al tare() bloqueante del arranque. Se alimenta desde la tarea de
+ * adquisición con los códigos crudos del ADC:
+ *   - Estado Settling: promedia las primeras N conversiones y fija el offset.
+ *   - Estado Tracking: agrupa las conversiones en bloques; si un bloque está cerca
+ *     del cero (|media| < banda de reposo) y con poca varianza, el pedal se considera
+ *     suelto y el offset se corrige una fracción del error. Así se sigue la deriva
+ *     térmica sin "comerse" una presión lenta y mantenida.
+ *
+ * Un pie apoyado con suavidad también es un bloque quieto dentro de la banda, así
+ * que antes de corregir se exige una permanencia: bloques seguidos en reposo, sin
+ * saltos entre bloques mayores que sigma. Pegado al cero actual (|media| <= sigma)
+ * bastan DWELL_BLOCKS: así se sigue la deriva térmica, que avanza poco a poco. Más
+ * lejos, dentro de la banda, solo se corrige si el pedal llegó ahí desde fuera de
+ * la banda (al soltar tras pisar, con la deriva acumulada mientras tanto) y tras
+ * DWELL_FAR_BLOCKS (minutos a 10 muestras/s). Apoyar el pie desde el reposo es un
+ * escalón desde el cero y no se corrige nunca; el compromiso es que un pie que
+ * afloja tras una frenada y se queda quieto dentro de la banda más de
+ * DWELL_FAR_BLOCKS sí acaba absorbido.
+ * Todo es aritmética entera. Los getters se leen desde el otro núcleo.
+ */
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+class AutoZero {
+public:
+    enum State : uint8_t {
+        Settling,  ///< Tomando la tara inicial; aún no hay offset válido
+        Tracking,  ///< Offset válido, siguiendo la deriva en reposo
+    };
+
+    /** Reinicia la tara tomando `samples` conversiones. Llamar antes de arrancar la tarea. */
+    void begin(uint8_t samples) {
+        tareSamples = samples ? samples : 1;
+        restart();
+    }
+
+    /** Pide una nueva tara desde otro núcleo; se atiende en el siguiente update(). */
+    void requestTare() { tareRequested = true; }
+
+    /**
+     * @brief Banda de reposo (unidades del ADC alrededor del offset) y desviación típica máxima en reposo.
+     * `sigma` es también la distancia al cero para contar reposo y el salto máximo entre bloques.
+     * Se puede llamar desde otro núcleo: como requestTare(), se aplica en el siguiente update().
+     */
+    void setIdleBand(int32_t band, int32_t sigma) {
+        pendingBand.store(band, std::memory_order_relaxed);
+        pendingSigma.store(sigma, std::memory_order_relaxed);
+        bandChanged.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Alimenta una conversión válida.
+     * @param code  código crudo del ADC (sin tara)
+     * @param nowUs marca de tiempo en micros()
+     * @return true si el offset cambió
+     */
+    bool update(int32_t code, uint32_t nowUs) {
+        // Si otra llamada a setIdleBand() se cruza con esta lectura, vuelve a
+        // levantar el aviso y el par completo se aplica en la muestra siguiente
+        if (bandChanged.exchange(false, std::memory_order_acquire)) {
+            idleBand = pendingBand.load(std::memory_order_relaxed);
+            idleSigma = pendingSigma.load(std::memory_order_relaxed);
+            idleVar = (int64_t)idleSigma * idleSigma;
+            idleBlocks = 0;
+        }
+        if (tareRequested) {
+            tareRequested = false;
+            restart();
+        }
+
+        if (state == Settling) {
+            sum += code;
+            if (++count < tareSamples) return false;
+            currentOffset = (int32_t)(sum / count);
+            state = Tracking;
+            rateOffset = currentOffset;
+            rateStartUs = nowUs;
+            idleBlocks = 0;
+            lastMean = 0;
+            released = false;
+            clearBlock();
+            return true;
+        }
+
+        // Tracking: estadística del bloque relativa al offset actual
+        const int64_t d = code - currentOffset;
+        sum += d;
+        sumSq += d * d;
+        if (++count < BLOCK) return false;
+
+        const int64_t mean = sum / BLOCK;
+        const int64_t var = sumSq / BLOCK - mean * mean;
+        clearBlock();
+
+        const int64_t absMean = mean < 0 ? -mean : mean;
+        const int64_t jump = mean - lastMean;
+        lastMean = mean;
+        if (absMean >= idleBand) released = true;        // Pisando: al volver puede traer deriva
+        else if (absMean <= idleSigma) released = false; // De vuelta en el cero
+        if (absMean >= idleBand || var > idleVar || (jump < 0 ? -jump : jump) > idleSigma) {
+            idleBlocks = 0; // Pisando, moviéndose o recién apoyado
+        } else if (idleBlocks < DWELL_FAR_BLOCKS) {
+            idleBlocks++;
+        }
+
+        bool changed = false;
+        const bool settled = absMean <= idleSigma ? idleBlocks >= DWELL_BLOCKS
+                                                  : released && idleBlocks >= DWELL_FAR_BLOCKS;
+        if (mean != 0 && settled) {
+            // Corregir 1/2^TRACK_SHIFT del error; al menos 1 cuenta para no estancarse
+            int32_t step = (int32_t)(mean >> TRACK_SHIFT);
+            if (step == 0) step = mean > 0 ? 1 : -1;
+            currentOffset += step;
+            lastMean -= step; // El siguiente bloque se mide ya contra el offset nuevo
+            changed = true;
+        }
+
+        // Velocidad de deriva (cuentas/minuto) medida sobre ventanas de RATE_PERIOD_US
+        const uint32_t elapsed = nowUs - rateStartUs;
+        if (elapsed >= RATE_PERIOD_US) {
+            drift = (int32_t)((int64_t)(currentOffset - rateOffset) * 60000000LL / elapsed);
+            rateOffset = currentOffset;
+            rateStartUs = nowUs;
+        }
+        return changed;
+    }
+
+    State getState() const { return state; }
+    bool ready() const { return state == Tracking; }
+    int32_t offset() const { return currentOffset; }
+    /** Deriva del cero medida en cuentas del ADC por minuto. */
+    int32_t driftPerMinute() const { return drift; }
+
+private:
+    static constexpr uint8_t BLOCK = 16;                 // Conversiones por bloque de análisis
+    static constexpr uint8_t TRACK_SHIFT = 5;            // Corrección de 1/32 del error por bloque
+    static constexpr uint8_t DWELL_BLOCKS = 8;           // Bloques en reposo junto al cero antes de corregir
+    static constexpr uint8_t DWELL_FAR_BLOCKS = 128;     // Idem, lejos del cero pero dentro de la banda
+    static constexpr uint32_t RATE_PERIOD_US = 10000000; // Ventana de medida de la deriva (10 s)
+
+    void restart() {
+        state = Settling;
+        drift = 0;
+        clearBlock();
+    }
+
+    void clearBlock() {
+        sum = 0;
+        sumSq = 0;
+        count = 0;
+    }
+
+    volatile State state = Settling;
+    volatile bool tareRequested = false;
+    std::atomic<bool> bandChanged{false};   // Escritos por setIdleBand() (Core 1),
+    std::atomic<int32_t> pendingBand{0};    // aplicados en update() (Core 0)
+    std::atomic<int32_t> pendingSigma{0};
+    volatile int32_t currentOffset = 0;
+    volatile int32_t drift = 0;
+    uint8_t tareSamples = 10;
+    int32_t idleBand = 0;
+    int32_t idleSigma = 0;
+    int64_t idleVar = 0;
+    int64_t lastMean = 0;     // Media del bloque anterior respecto al offset
+    uint8_t idleBlocks = 0;   // Bloques seguidos en reposo
+    bool released = false;    // Llegó a la banda desde fuera (tras pisar), no desde el cero
+    int64_t sum = 0;
+    int64_t sumSq = 0;
+    uint16_t count = 0;
+    int32_t rateOffset = 0;
+    uint32_t rateStartUs = 0;
+};
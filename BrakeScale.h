@@ -0,0 +1,39 @@
+/**
+ * @file BrakeScale.h
+ * @brief Escalado de la célula de carga con tara a 0..fondo de escala con aritmética entera.
+ *
+ * El factor fondo / fuerza máxima se calcula en Q8.24 al cambiar la calibración; por
+ * muestra solo quedan una multiplicación 32x32->64, un desplazamiento y el recorte.
+ * Sustituye al float que multiplicaba cada muestra después de pasarla por el
+ * get_value() en double de la librería del HX711.
+ */
+#pragma once
+#include <Arduino.h>
+
+class BrakeScale {
+public:
+    static constexpr uint8_t SHIFT = 24;
+
+    /** maxForce: cuentas con tara que dan el fondo de escala. Con maxForce <= 128 el factor satura. */
+    void configure(float maxForce, int32_t fullScale) {
+        int64_t force = (int64_t)maxForce;
+        if (force < 1) force = 1;
+        full = fullScale;
+        const int64_t q = ((int64_t)fullScale << SHIFT) / force;
+        factorQ = q > INT32_MAX ? INT32_MAX : (int32_t)q;
+    }
+
+    /** Muestra con tara -> 0..fullScale. */
+    inline int32_t apply(int32_t raw) const {
+        const int64_t v = ((int64_t)raw * factorQ) >> SHIFT;
+        if (v < 0) return 0;
+        if (v > full) return full;
+        return (int32_t)v;
+    }
+
+    int32_t factor() const { return factorQ; }
+
+private:
+    int32_t factorQ = 0;
+    int32_t full = 0;
+};
@@ -0,0 +1,43 @@
+/**
+ * @file Deadband.h
+ * @brief Zonas muertas en los extremos del recorrido, reescalando el resto a toda la escala.
+ *
+ * Los primeros `low` y los últimos `high` cuentas se fijan a 0 y al fondo de escala:
+ * el pedal suelto da 0 aunque la calibración quede justa y el tope se alcanza
+ * sin apurar el recorrido. Entre medias la salida se reescala para seguir cubriendo
+ * 0..fullScale. El factor se precalcula en Q16; por muestra hay una multiplicación.
+ * Con las dos zonas a 0 la etapa deja pasar el valor.
+ */
+#pragma once
+#include <Arduino.h>
+
+class Deadband {
+public:
+    static constexpr uint8_t SCALE_BITS = 16;
+    static constexpr uint8_t MAX_PERCENT = 25; // Por zona; garantiza que el factor cabe en 32 bits
+
+    /** Zonas muertas en % del recorrido (0..MAX_PERCENT cada una). */
+    void configure(uint8_t lowPct, uint8_t highPct, int32_t fullScale) {
+        if (lowPct > MAX_PERCENT) lowPct = MAX_PERCENT;
+        if (highPct > MAX_PERCENT) highPct = MAX_PERCENT;
+        scale = fullScale > 0 ? fullScale : 1;
+        low = scale * lowPct / 100;
+        high = scale - scale * highPct / 100;
+        active = low > 0 || high < scale;
+        factorQ = ((uint32_t)scale << SCALE_BITS) / (uint32_t)(high - low);
+    }
+
+    inline int32_t update(int32_t x, uint32_t) {
+        if (!active) return x;
+        if (x <= low) return 0;
+        if (x >= high) return scale;
+        return (int32_t)(((uint32_t)(x - low) * factorQ + (1u << (SCALE_BITS - 1))) >> SCALE_BITS);
+    }
+
+private:
+    int32_t scale = 1;
+    int32_t low = 0;       // Por debajo: 0
+    int32_t high = 1;      // Por encima: fondo de escala
+    uint32_t factorQ = 1u << SCALE_BITS;
+    bool active = false;
+};
@@ -0,0 +1,108 @@
+/**
+ * @file EmaFilter.h
+ * @brief Filtro paso bajo RC de primer orden en punto fijo, consciente del tiempo entre muestras.
+ *
+ * Se configura por frecuencia de corte (Hz) y cada muestra llega con su marca de
+ * tiempo en micros(): el peso de la muestra nueva se calcula con el dt real,
+ * k = 1 - exp(-dt / tau) con tau = 1 / (2 pi fc). Es la discretización exacta del
+ * RC, así que el suavizado es el mismo aunque loop() vaya rápido en reposo o se
+ * pare decenas de ms pintando la pantalla, y el freno (10-80 muestras/s, dt del
+ * orden de tau) se comporta igual que gas/embrague. fc = 0 desactiva el filtro.
+ *
+ * k sale de una tabla Q15 de 1 - exp(-x) indexada por x = dt / tau en pasos de
+ * 1/128 hasta x = 8, con interpolación lineal (error < 1 LSB); más allá k = 1 (el
+ * valor exacto difiere menos de un 0.04 %). dt / tau se obtiene
+ * multiplicando por 1/tau, precalculado al fijar el corte: por muestra no hay
+ * divisiones. El estado guarda FRAC_BITS bits fraccionarios, así que la salida
+ * sigue acercándose a la entrada aunque la diferencia por paso sea menor que una
+ * cuenta, y tanto el paso como la salida se redondean al más cercano.
+ */
+#pragma once
+#include <Arduino.h>
+
+class EmaFilter {
+public:
+    static constexpr uint8_t COEF_BITS = 15;        // Coeficiente en Q15
+    static constexpr uint8_t FRAC_BITS = 8;         // Bits fraccionarios del estado
+    static constexpr uint32_t US_PER_RAD = 159155;  // 1e6 / (2 pi): tau en us = US_PER_RAD / fc
+    static constexpr uint8_t LUT_STEP_BITS = 7;     // Paso de la tabla: dt / tau = 1/128
+    static constexpr uint16_t LUT_SIZE = (8 << LUT_STEP_BITS) + 1; // Hasta dt / tau = 8 (exp(-8) < 0.04%)
+    static constexpr uint8_t RATIO_BITS = 16;       // dt / tau en Q16
+
+    /** Constante de tiempo (us) para una frecuencia de corte en décimas de Hz (0 = sin filtro). */
+    static uint32_t tauForDeciHz(uint32_t deciHz) {
+        return deciHz ? (US_PER_RAD * 10 + deciHz / 2) / deciHz : 0;
+    }
+
+    /** Peso de la muestra nueva, 1 - exp(-dt / tau) en Q15, para dt / tau en Q16. */
+    static uint32_t coefficient(uint64_t ratioQ16) {
+        constexpr uint8_t fracBits = RATIO_BITS - LUT_STEP_BITS;
+        const uint64_t idx = ratioQ16 >> fracBits;
+        if (idx >= LUT_SIZE - 1) return 1u << COEF_BITS;
+        const uint16_t* t = table();
+        const uint32_t frac = (uint32_t)ratioQ16 & ((1u << fracBits) - 1);
+        return t[idx] + (((t[idx + 1] - t[idx]) * frac + (1u << (fracBits - 1))) >> fracBits);
+    }
+
+    /** Fija la frecuencia de corte en Hz (0 = sin filtro). */
+    void setCutoffHz(uint16_t hz) { setTauUs(tauForDeciHz((uint32_t)hz * 10)); }
+
+    /** Fija directamente la constante de tiempo; la usan los filtros de corte variable. */
+    void setTauUs(uint32_t tau) {
+        if (tau == tauUs) return;
+        tauUs = tau;
+        const uint64_t inv = tau ? ((((uint64_t)1 << 32) + tau / 2) / tau) : 0;
+        invTauQ32 = inv > UINT32_MAX ? UINT32_MAX : (uint32_t)inv;
+    }
+
+    /** Coloca el filtro en un valor sin transitorio; el siguiente dt se mide desde `nowUs`. */
+    void reset(int32_t v, uint32_t nowUs) {
+        state = v << FRAC_BITS;
+        lastUs = nowUs;
+        primed = true;
+    }
+
+    /**
+     * @brief Alimenta una muestra tomada en `nowUs` (micros()) y devuelve la salida redondeada.
+     * La primera muestra inicializa el filtro sin rampa desde 0.
+     */
+    inline int32_t update(int32_t x, uint32_t nowUs) {
+        if (!primed || tauUs == 0) {
+            reset(x, nowUs);
+            return x;
+        }
+        const uint32_t dt = nowUs - lastUs; // Aritmética sin signo: soporta el desbordamiento de micros()
+        lastUs = nowUs;
+
+        const uint32_t k = coefficient(((uint64_t)dt * invTauQ32) >> (32 - RATIO_BITS));
+        const int64_t step = (int64_t)((x << FRAC_BITS) - state) * k;
+        state += (int32_t)((step + (1 << (COEF_BITS - 1))) >> COEF_BITS);
+        return value();
+    }
+
+    /** Última salida, redondeada a cuentas enteras. */
+    int32_t value() const { return (state + (1 << (FRAC_BITS - 1))) >> FRAC_BITS; }
+
+private:
+    // Tabla de 1 - exp(-i / 128) en Q15, compartida por todos los filtros. Se rellena
+    // una vez en el primer uso (inicialización estática protegida); 2 KB de RAM.
+    static const uint16_t* table() {
+        struct Lut {
+            uint16_t v[LUT_SIZE];
+            Lut() {
+                for (uint16_t i = 0; i < LUT_SIZE; i++) {
+                    const float x = (float)i / (1 << LUT_STEP_BITS);
+                    v[i] = (uint16_t)lroundf((1.0f - expf(-x)) * (1 << COEF_BITS));
+                }
+            }
+        };
+        static const Lut lut;
+        return lut.v;
+    }
+
+    uint32_t tauUs = 0;     // Constante de tiempo en us; 0 = sin filtro
+    uint32_t invTauQ32 = 0; // 2^32 / tauUs
+    uint32_t lastUs = 0;    // Marca de tiempo de la última muestra
+    int32_t state = 0;      // Salida con FRAC_BITS bits fraccionarios
+    bool primed = false;
+};
@@ -0,0 +1,71 @@
+/**
+ * @file FilterChain.h
+ * @brief Cadena de filtros compuesta en compilación: FilterChain<Etapa1, Etapa2, ...>.
+ *
+ * Cada etapa es una clase con `int32_t update(int32_t x, uint32_t nowUs)`, que
+ * recibe la muestra y su marca de tiempo (EmaFilter, OneEuroFilter, Deadband,
+ * SpikeReject...). La cadena guarda una instancia de cada etapa por valor y las
+ * encadena por recursión de plantillas: no hay llamadas virtuales y el compilador
+ * lo reduce todo a código en línea. Una etapa que no aparece en la lista no existe
+ * en el binario.
+ *
+ * Los parámetros se fijan por etapa con with<Etapa>(f), que llama a f(etapa) si la
+ * cadena la contiene y no hace nada si no, de modo que el mismo código de
+ * configuración sirve para cadenas con composiciones distintas.
+ */
+#pragma once
+#include <Arduino.h>
+#include "SimRacing.h"
+
+template<typename... Stages>
+class FilterChain;
+
+// Cadena vacía: deja pasar el valor
+template<>
+class FilterChain<> {
+public:
+    inline int32_t update(int32_t x, uint32_t) { return x; }
+
+    template<typename Stage, typename F>
+    void with(F&&) {}
+};
+
+template<typename First, typename... Rest>
+class FilterChain<First, Rest...> {
+public:
+    /** Pasa una muestra tomada en `nowUs` por todas las etapas, en orden. */
+    inline int32_t update(int32_t x, uint32_t nowUs) {
+        return rest.update(first.update(x, nowUs), nowUs);
+    }
+
+    /** Llama a `f(etapa)` con la primera etapa de tipo `Stage`, si existe. */
+    template<typename Stage, typename F>
+    void with(F&& f) { visit(f, Tag<Stage>()); }
+
+private:
+    template<typename Stage> struct Tag {};
+
+    // La sobrecarga con Tag<First> es más especializada y gana cuando Stage == First
+    template<typename F>
+    void visit(F& f, Tag<First>) { f(first); }
+
+    template<typename F, typename Stage>
+    void visit(F& f, Tag<Stage>) { rest.template with<Stage>(f); }
+
+    First first;
+    FilterChain<Rest...> rest;
+};
+
+// Etapa de rechazo de picos (mediana de 3) sobre SimRacing::SpikeRejector.
+// Gas y embrague ya la aplican por conversión en el ADC y el freno en la tarea
+// de adquisición; queda para cadenas que trabajen sobre otras fuentes.
+class SpikeReject {
+public:
+    void setThreshold(int threshold) { rejector.setThreshold(threshold); }
+    uint32_t getCount() const { return rejector.getCount(); }
+
+    inline int32_t update(int32_t x, uint32_t) { return rejector.filter(x); }
+
+private:
+    SimRacing::SpikeRejector rejector;
+};
@@ -0,0 +1,101 @@
+/**
+ * @file GlitchRejector.h
+ * @brief Etapa de rechazo de glitches y outliers para muestras de célula de carga.
+ *
+ * Un pulso de PD_SCK estirado por encima de 60 us o un cable dudoso hacen que el
+ * HX711 devuelva códigos saturados (0x7FFFFF / 0x800000) o todo unos. Esta etapa
+ * corre en la tarea de adquisición, por muestra y en O(1):
+ *   1. descarta los códigos de saturación / todo unos,
+ *   2. mediana de 3 (añade una muestra de retardo, elimina picos aislados),
+ *   3. limita la velocidad de cambio entre muestras aceptadas (slew): el salto
+ *      máximo es una fuerza por segundo multiplicada por el dt real entre muestras,
+ *      así que no depende de la tasa del ADC. Solo se rechaza un outlier aislado:
+ *      si la muestra siguiente también supera el límite se toma como un pisotón real
+ *      (como mucho una muestra de retardo, más la de la mediana).
+ * Los contadores se leen desde el otro núcleo (lecturas de 32 bits atómicas).
+ */
+#pragma once
+#include <Arduino.h>
+
+class GlitchRejector {
+public:
+    /** Contadores de muestras desde el arranque o el último reset. */
+    struct Counters {
+        uint32_t accepted;   ///< Muestras entregadas
+        uint32_t saturated;  ///< Códigos 0x7FFFFF / 0x800000 / 0xFFFFFF descartados
+        uint32_t slew;       ///< Muestras que superaban el salto máximo
+    };
+
+    /** Códigos de 24 bits (con extensión de signo) que el HX711 nunca da en una lectura sana. */
+    static bool isInvalidCode(int32_t code) {
+        return code == 0x7FFFFF || code == -0x800000 || code == -1;
+    }
+
+    /**
+     * @brief Fija la velocidad máxima de cambio (unidades de la muestra por segundo).
+     * 0 desactiva la comprobación.
+     */
+    void setMaxRate(int32_t countsPerSecond) { maxRate = countsPerSecond; }
+
+    /**
+     * @brief Procesa una conversión.
+     * @param code  código crudo del ADC (read(), sin tara) para detectar saturación
+     * @param value valor con tara aplicado a la misma conversión
+     * @param us    micros() del dato listo de la conversión
+     * @param out   muestra filtrada si se acepta
+     * @return true si hay una muestra nueva en `out`
+     */
+    bool process(int32_t code, int32_t value, uint32_t us, int32_t& out) {
+        if (isInvalidCode(code)) {
+            counts.saturated++;
+            return false;
+        }
+
+        // Mediana de 3: hasta tener 3 muestras se entrega la última
+        hist[pos] = value;
+        pos = (pos + 1) % 3;
+        if (fill < 3) fill++;
+        int32_t m = (fill < 3) ? value : median3(hist[0], hist[1], hist[2]);
+
+        // Limitador de slew sobre el dt desde la última muestra aceptada. Tras
+        // SLEW_RESYNC rechazos seguidos se asume un cambio real.
+        if (hasLast && maxRate > 0 && slewRun < SLEW_RESYNC) {
+            const int64_t limit = (int64_t)maxRate * (uint32_t)(us - lastUs) / 1000000;
+            if (abs(m - last) > limit) {
+                slewRun++;
+                counts.slew++;
+                return false;
+            }
+        }
+        slewRun = 0;
+        last = m;
+        lastUs = us;
+        hasLast = true;
+        counts.accepted++;
+        out = m;
+        return true;
+    }
+
+    const Counters& counters() const { return counts; }
+    void resetCounters() { counts = {0, 0, 0}; }
+
+    /** Olvida el historial (p.ej. tras cambiar la tara). */
+    void reset() { fill = 0; pos = 0; hasLast = false; slewRun = 0; }
+
+private:
+    static constexpr uint8_t SLEW_RESYNC = 1;
+
+    static int32_t median3(int32_t a, int32_t b, int32_t c) {
+        return max(min(a, b), min(max(a, b), c));
+    }
+
+    int32_t hist[3] = {0, 0, 0};
+    uint8_t fill = 0;
+    uint8_t pos = 0;
+    int32_t last = 0;
+    uint32_t lastUs = 0;
+    bool hasLast = false;
+    uint8_t slewRun = 0;
+    int32_t maxRate = 0;
+    Counters counts = {0, 0, 0};
+};
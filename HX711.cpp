@@ -69,50 +69,21 @@ uint8_t shiftInSlow(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
 #endif
 
 
-HX711::HX711() {
-}
-
-HX711::~HX711() {
-}
-
-void HX711::begin(byte dout, byte pd_sck, byte gain) {
+void HX711GpioBackend::begin(byte dout, byte pd_sck) {
 	PD_SCK = pd_sck;
 	DOUT = dout;
 
 	pinMode(PD_SCK, OUTPUT);
 	pinMode(DOUT, DOUT_MODE);
-
-	set_gain(gain);
 }
 
-bool HX711::is_ready() {
+bool HX711GpioBackend::is_ready() {
 	return digitalRead(DOUT) == LOW;
 }
 
-void HX711::set_gain(byte gain) {
-	switch (gain) {
-		case 128:		// channel A, gain factor 128
-			GAIN = 1;
-			break;
-		case 64:		// channel A, gain factor 64
-			GAIN = 3;
-			break;
-		case 32:		// channel B, gain factor 32
-			GAIN = 2;
-			break;
-	}
-
-}
-
-long HX711::read() {
-
-	// Wait for the chip to become ready.
-	wait_ready();
-
+uint32_t HX711GpioBackend::read_raw(byte gain_pulses) {
 	// Define structures for reading data into.
-	unsigned long value = 0;
 	uint8_t data[3] = { 0 };
-	uint8_t filler = 0x00;
 
 	// Protect the read sequence from system interrupts.  If an interrupt occurs during
 	// the time the PD_SCK signal is high it will stretch the length of the clock pulse.
@@ -150,7 +121,7 @@ long HX711::read() {
 	data[0] = SHIFTIN_WITH_SPEED_SUPPORT(DOUT, PD_SCK, MSBFIRST);
 
 	// Set the channel and the gain factor for the next reading using the clock pin.
-	for (unsigned int i = 0; i < GAIN; i++) {
+	for (unsigned int i = 0; i < gain_pulses; i++) {
 		digitalWrite(PD_SCK, HIGH);
 		#if ARCH_ESPRESSIF
 		delayMicroseconds(1);
@@ -173,20 +144,102 @@ long HX711::read() {
 	interrupts();
 	#endif
 
+	return ( static_cast<uint32_t>(data[2]) << 16
+			| static_cast<uint32_t>(data[1]) << 8
+			| static_cast<uint32_t>(data[0]) );
+}
+
+void HX711GpioBackend::set_clock(bool high) {
+	digitalWrite(PD_SCK, high ? HIGH : LOW);
+}
+
+
+HX711::HX711() {
+}
+
+HX711::HX711(byte dout, byte pd_sck, byte gain)
+	: PIN_DOUT(dout), PIN_SCK(pd_sck), GAIN_SETTING(gain) {
+}
+
+HX711::~HX711() {
+}
+
+void HX711::set_backend(HX711Backend* backend) {
+	this->backend = backend ? backend : &gpio_backend;
+}
+
+void HX711::begin(byte dout, byte pd_sck, byte gain) {
+	PIN_DOUT = dout;
+	PIN_SCK = pd_sck;
+	GAIN_SETTING = gain;
+
+	backend->begin(dout, pd_sck);
+
+	set_gain(gain);
+}
+
+bool HX711::begin() {
+	begin(PIN_DOUT, PIN_SCK, GAIN_SETTING);
+	return true;
+}
+
+bool HX711::is_ready() {
+	return backend->is_ready();
+}
+
+void HX711::set_gain(byte gain) {
+	switch (gain) {
+		case 128:		// channel A, gain factor 128
+			GAIN = 1;
+			break;
+		case 64:		// channel A, gain factor 64
+			GAIN = 3;
+			break;
+		case 32:		// channel B, gain factor 32
+			GAIN = 2;
+			break;
+	}
+
+}
+
+long HX711::read() {
+
+	// Wait for the chip to become ready.
+	wait_ready();
+
+	// Clock the 24-bit word (plus gain pulses) out of the chip.
+	#if ARCH_ESPRESSIF
+	uint32_t start = ESP.getCycleCount();
+	uint32_t raw = backend->read_raw(GAIN) & 0xFFFFFF;
+	READ_CYCLES = ESP.getCycleCount() - start;
+	#else
+	uint32_t raw = backend->read_raw(GAIN) & 0xFFFFFF;
+	#endif
+
 	// Replicate the most significant bit to pad out a 32-bit signed integer
-	if (data[2] & 0x80) {
-		filler = 0xFF;
-	} else {
-		filler = 0x00;
+	if (raw & 0x800000) {
+		raw |= 0xFF000000;
 	}
 
-	// Construct a 32-bit signed integer
-	value = ( static_cast<unsigned long>(filler) << 24
-			| static_cast<unsigned long>(data[2]) << 16
-			| static_cast<unsigned long>(data[1]) << 8
-			| static_cast<unsigned long>(data[0]) );
+	long value = static_cast<long>(static_cast<int32_t>(raw));
+	push_window(value);
+	return value;
+}
+
+void HX711::set_rate(uint16_t sps) {
+	RATE = sps;
+}
+
+uint16_t HX711::sample_rate() {
+	return RATE;
+}
+
+int HX711::ready_pin() {
+	return PIN_DOUT;
+}
 
-	return static_cast<long>(value);
+uint32_t HX711::get_read_cycles() {
+	return READ_CYCLES;
 }
 
 void HX711::wait_ready(unsigned long delay_ms) {
@@ -228,51 +281,11 @@ bool HX711::wait_ready_timeout(unsigned long timeout, unsigned long delay_ms) {
 	return false;
 }
 
-long HX711::read_average(byte times) {
-	long sum = 0;
-	for (byte i = 0; i < times; i++) {
-		sum += read();
-		// Probably will do no harm on AVR but will feed the Watchdog Timer (WDT) on ESP.
-		// https://github.com/bogde/HX711/issues/73
-		delay(0);
-	}
-	return sum / times;
-}
-
-double HX711::get_value(byte times) {
-	return read_average(times) - OFFSET;
-}
-
-float HX711::get_units(byte times) {
-	return get_value(times) / SCALE;
-}
-
-void HX711::tare(byte times) {
-	double sum = read_average(times);
-	set_offset(sum);
-}
-
-void HX711::set_scale(float scale) {
-	SCALE = scale;
-}
-
-float HX711::get_scale() {
-	return SCALE;
-}
-
-void HX711::set_offset(long offset) {
-	OFFSET = offset;
-}
-
-long HX711::get_offset() {
-	return OFFSET;
-}
-
 void HX711::power_down() {
-	digitalWrite(PD_SCK, LOW);
-	digitalWrite(PD_SCK, HIGH);
+	backend->set_clock(false);
+	backend->set_clock(true);
 }
 
 void HX711::power_up() {
-	digitalWrite(PD_SCK, LOW);
+	backend->set_clock(false);
 }
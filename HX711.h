@@ -16,19 +16,64 @@
 #include "WProgram.h"
 #endif
 
-class HX711
+#include "LoadCellADC.h"
+
+// Low-level transport used by HX711 to talk to the chip.
+// The backend owns the pins and produces the PD_SCK burst; HX711 only deals with
+// timing of conversions, gain selection and sign extension. This lets the clock
+// be generated by a hardware peripheral, or by a mock when testing off-target.
+class HX711Backend
+{
+	public:
+		virtual ~HX711Backend() {}
+
+		// Configure the data output and clock input pins
+		virtual void begin(byte dout, byte pd_sck) = 0;
+
+		// Level of DOUT: LOW means a conversion is ready for retrieval
+		virtual bool is_ready() = 0;
+
+		// Clock out the 24 data bits followed by `gain_pulses` extra pulses that select
+		// the channel and gain of the next conversion. Returns the raw 24-bit word, MSB first.
+		virtual uint32_t read_raw(byte gain_pulses) = 0;
+
+		// Drive PD_SCK to a static level (HIGH for > 60 us powers the chip down)
+		virtual void set_clock(bool high) = 0;
+};
+
+// Default backend: bit-bangs PD_SCK from the CPU inside a critical section
+class HX711GpioBackend : public HX711Backend
 {
 	private:
 		byte PD_SCK;	// Power Down and Serial Clock Input Pin
 		byte DOUT;		// Serial Data Output Pin
+
+	public:
+		void begin(byte dout, byte pd_sck) override;
+		bool is_ready() override;
+		uint32_t read_raw(byte gain_pulses) override;
+		void set_clock(bool high) override;
+};
+
+class HX711 : public LoadCellADC
+{
+	private:
+		HX711GpioBackend gpio_backend;	// used unless set_backend() is called
+		HX711Backend* backend = &gpio_backend;
 		byte GAIN;		// amplification factor
-		long OFFSET = 0;	// used for tare weight
-		float SCALE = 1;	// used to return weight in grams, kg, ounces, whatever
+		byte PIN_DOUT = 0;	// pins and gain given to the constructor, used by begin()
+		byte PIN_SCK = 0;
+		byte GAIN_SETTING = 128;
+		uint16_t RATE = 10;	// conversion rate strapped on the RATE pin (10 or 80 SPS)
+		uint32_t READ_CYCLES = 0;	// CPU cycles spent in the backend during the last read()
 
 	public:
 
 		HX711();
 
+		// Store pins and gain so the chip can be started through LoadCellADC::begin()
+		HX711(byte dout, byte pd_sck, byte gain = 128);
+
 		virtual ~HX711();
 
 		// Initialize library with data output pin, clock input pin and gain factor.
@@ -38,10 +83,17 @@ class HX711
 		// The library default is "128" (Channel A).
 		void begin(byte dout, byte pd_sck, byte gain = 128);
 
+		// Initialize with the pins and gain given to the constructor
+		bool begin() override;
+
+		// Replace the transport used to clock data out of the chip; call before begin().
+		// The backend must outlive this object.
+		void set_backend(HX711Backend* backend);
+
 		// Check if HX711 is ready
 		// from the datasheet: When output data is not ready for retrieval, digital output pin DOUT is high. Serial clock
 		// input PD_SCK should be low. When DOUT goes to low, it indicates data is ready for retrieval.
-		bool is_ready();
+		bool is_ready() override;
 
 		// Wait for the HX711 to become ready
 		void wait_ready(unsigned long delay_ms = 0);
@@ -53,33 +105,19 @@ class HX711
 		// depending on the parameter, the channel is also set to either A or B
 		void set_gain(byte gain = 128);
 
-		// waits for the chip to be ready and returns a reading
-		long read();
-
-		// returns an average reading; times = how many times to read
-		long read_average(byte times = 10);
-
-		// returns (read_average() - OFFSET), that is the current value without the tare weight; times = how many readings to do
-		double get_value(byte times = 1);
-
-		// returns get_value() divided by SCALE, that is the raw value divided by a value obtained via calibration
-		// times = how many readings to do
-		float get_units(byte times = 1);
+		// declare the conversion rate selected by the RATE pin (10 or 80 SPS); the chip cannot report it
+		void set_rate(uint16_t sps);
+		uint16_t sample_rate() override;
 
-		// set the OFFSET value for tare weight; times = how many times to read the tare value
-		void tare(byte times = 10);
+		// DOUT falls when a conversion is ready
+		int ready_pin() override;
 
-		// set the SCALE value; this value is used to convert the raw data to "human readable" data (measure units)
-		void set_scale(float scale = 1.f);
-
-		// get the current SCALE
-		float get_scale();
-
-		// set OFFSET, the value that's subtracted from the actual reading (tare weight)
-		void set_offset(long offset = 0);
+		// waits for the chip to be ready and returns a reading
+		long read() override;
 
-		// get the current OFFSET
-		long get_offset();
+		// CPU cycles the backend spent clocking out the last reading (0 where no cycle counter is available).
+		// On the GPIO backend this is the length of the critical section.
+		uint32_t get_read_cycles() override;
 
 		// puts the chip into power down mode
 		void power_down();
@@ -0,0 +1,97 @@
+/**
+ * @file HX711Fast.h
+ * @brief Variante del HX711 con pines fijados en compilación y acceso directo a los registros GPIO.
+ *
+ * Cada flanco de PD_SCK es una única escritura en GPIO_OUT_W1TS/W1TC y cada bit se
+ * muestrea con una lectura de GPIO_IN, sin pasar por la búsqueda genérica de
+ * digitalWrite()/digitalRead(). Las máscaras y registros se resuelven en compilación,
+ * por lo que la sección crítica es más corta y su duración no depende del pin.
+ * La duración real se puede comparar con HX711::get_read_cycles(). En el PC,
+ * test/test_hx711_fast.cpp lo prueba contra un HX711 simulado tras los registros y
+ * `make bench` cuenta accesos y ciclos de espera frente al backend GPIO.
+ */
+#pragma once
+#include <Arduino.h>
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#include "HX711.h"
+
+/** Semiperiodo de PD_SCK en ns. El HX711 exige >= 200 ns en alto y en bajo. */
+#define HX711_FAST_HALF_PERIOD_NS 250
+
+/**
+ * @brief Backend HX711 que conmuta PD_SCK por registros (ESP32-S3, GPIO 0..48).
+ * @tparam DOUT_PIN pin de datos del HX711
+ * @tparam SCK_PIN  pin de reloj PD_SCK
+ */
+template<uint8_t DOUT_PIN, uint8_t SCK_PIN>
+class HX711FastBackend : public HX711Backend {
+    static_assert(DOUT_PIN < 49 && SCK_PIN < 49, "HX711Fast: pin GPIO fuera de rango en ESP32-S3");
+
+    // Los GPIO 0..31 están en el primer banco y 32..48 en el segundo
+    static constexpr uint32_t DOUT_MASK = 1UL << (DOUT_PIN & 31);
+    static constexpr uint32_t SCK_MASK  = 1UL << (SCK_PIN & 31);
+    static constexpr uint32_t IN_REG    = DOUT_PIN < 32 ? GPIO_IN_REG : GPIO_IN1_REG;
+    static constexpr uint32_t SET_REG   = SCK_PIN < 32 ? GPIO_OUT_W1TS_REG : GPIO_OUT1_W1TS_REG;
+    static constexpr uint32_t CLR_REG   = SCK_PIN < 32 ? GPIO_OUT_W1TC_REG : GPIO_OUT1_W1TC_REG;
+    static constexpr uint32_t HOLD_CYCLES = (uint32_t)((uint64_t)F_CPU * HX711_FAST_HALF_PERIOD_NS / 1000000000ULL);
+
+    static inline void sckHigh() { REG_WRITE(SET_REG, SCK_MASK); }
+    static inline void sckLow()  { REG_WRITE(CLR_REG, SCK_MASK); }
+    static inline uint32_t doutBit() { return (REG_READ(IN_REG) & DOUT_MASK) ? 1 : 0; }
+
+    /** Espera activa por contador de ciclos (no depende de delayMicroseconds). */
+    static inline void hold() {
+        uint32_t start = ESP.getCycleCount();
+        while (ESP.getCycleCount() - start < HOLD_CYCLES) {}
+    }
+
+public:
+    /** Los argumentos se ignoran: los pines son los del template. */
+    void begin(byte, byte) override {
+        pinMode(SCK_PIN, OUTPUT);
+        sckLow();
+        pinMode(DOUT_PIN, INPUT);
+    }
+
+    bool is_ready() override { return doutBit() == 0; }
+
+    uint32_t read_raw(byte gain_pulses) override {
+        uint32_t value = 0;
+        const uint8_t pulses = 24 + gain_pulses;
+
+        // Igual que el backend GPIO: un pulso en alto de más de 60 us apagaría el chip
+        portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+        portENTER_CRITICAL(&mux);
+        for (uint8_t i = 0; i < pulses; i++) {
+            sckHigh();
+            hold();                             // DOUT válido 0.1 us tras el flanco de subida
+            value = (value << 1) | doutBit();
+            sckLow();
+            hold();
+        }
+        portEXIT_CRITICAL(&mux);
+
+        return value >> gain_pulses;            // Descartar los bits leídos durante los pulsos de ganancia
+    }
+
+    void set_clock(bool high) override {
+        if (high) sckHigh(); else sckLow();
+    }
+};
+
+/**
+ * @brief HX711 con pines constexpr. Sustituto directo de HX711.
+ *
+ * Uso:
+ *   HX711Fast<LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN> brake_pedal;
+ *   brake_pedal.begin();   // LoadCellADC::begin(), pines del template
+ */
+template<uint8_t DOUT_PIN, uint8_t SCK_PIN>
+class HX711Fast : public HX711 {
+public:
+    HX711Fast(byte gain = 128) : HX711(DOUT_PIN, SCK_PIN, gain) { set_backend(&fast); }
+
+private:
+    HX711FastBackend<DOUT_PIN, SCK_PIN> fast;
+};
@@ -0,0 +1,180 @@
+/**
+ *
+ * Synchronized reader for several HX711 chips sharing one PD_SCK line.
+ *
+**/
+#include <Arduino.h>
+#include "HX711Multi.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#endif
+
+HX711Multi::HX711Multi(byte count, const byte* dout, byte pd_sck, byte gain)
+	: COUNT(count > HX711_MULTI_MAX ? HX711_MULTI_MAX : count), PD_SCK(pd_sck) {
+	for (byte i = 0; i < COUNT; i++) {
+		DOUT[i] = dout[i];
+	}
+	set_gain(gain);
+}
+
+void HX711Multi::begin() {
+	pinMode(PD_SCK, OUTPUT);
+	clock(false);
+	for (byte i = 0; i < COUNT; i++) {
+		pinMode(DOUT[i], INPUT);
+	}
+}
+
+void HX711Multi::set_gain(byte gain) {
+	switch (gain) {
+		case 128:		// channel A, gain factor 128
+			GAIN = 1;
+			break;
+		case 64:		// channel A, gain factor 64
+			GAIN = 3;
+			break;
+		case 32:		// channel B, gain factor 32
+			GAIN = 2;
+			break;
+	}
+}
+
+uint64_t HX711Multi::read_inputs() {
+	#if defined(ARDUINO_ARCH_ESP32)
+	// Both GPIO input banks, read back to back: every DOUT is sampled on the same pulse
+	return static_cast<uint64_t>(REG_READ(GPIO_IN_REG))
+		| (static_cast<uint64_t>(REG_READ(GPIO_IN1_REG)) << 32);
+	#else
+	uint64_t inputs = 0;
+	for (byte i = 0; i < COUNT; i++) {
+		if (digitalRead(DOUT[i]) == HIGH) {
+			inputs |= static_cast<uint64_t>(1) << DOUT[i];
+		}
+	}
+	return inputs;
+	#endif
+}
+
+void HX711Multi::clock(bool high) {
+	#if defined(ARDUINO_ARCH_ESP32)
+	if (PD_SCK < 32) {
+		REG_WRITE(high ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1UL << PD_SCK);
+	} else {
+		REG_WRITE(high ? GPIO_OUT1_W1TS_REG : GPIO_OUT1_W1TC_REG, 1UL << (PD_SCK - 32));
+	}
+	#else
+	digitalWrite(PD_SCK, high ? HIGH : LOW);
+	#endif
+}
+
+bool HX711Multi::is_ready() {
+	for (byte i = 0; i < COUNT; i++) {
+		if (digitalRead(DOUT[i]) != LOW) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void HX711Multi::shift_in_bit(uint64_t inputs, const byte* dout, byte count, uint32_t* acc) {
+	for (byte i = 0; i < count; i++) {
+		acc[i] = (acc[i] << 1) | static_cast<uint32_t>((inputs >> dout[i]) & 1);
+	}
+}
+
+long HX711Multi::sign_extend(uint32_t raw) {
+	raw &= 0xFFFFFF;
+	if (raw & 0x800000) {
+		raw |= 0xFF000000;
+	}
+	return static_cast<long>(static_cast<int32_t>(raw));
+}
+
+bool HX711Multi::read(long* values, unsigned long timeout_ms) {
+	// The chips convert independently: wait until every DOUT is low
+	unsigned long started = millis();
+	while (!is_ready()) {
+		if (millis() - started >= timeout_ms) {
+			return false;
+		}
+		delay(0);
+	}
+
+	uint32_t acc[HX711_MULTI_MAX] = { 0 };
+	LAST_READ_US = micros();
+
+	// Same reasoning as HX711: a clock pulse stretched past 60 us by an interrupt
+	// would power the chips down mid-read, so the burst runs in a critical section.
+	#if defined(ARDUINO_ARCH_ESP32)
+	portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+	portENTER_CRITICAL(&mux);
+	#else
+	noInterrupts();
+	#endif
+
+	for (byte i = 0; i < 24 + GAIN; i++) {
+		clock(true);
+		delayMicroseconds(1);
+		uint64_t inputs = read_inputs();
+		clock(false);
+		// Only the 24 data bits are kept; the extra pulses just select the next gain
+		if (i < 24) {
+			shift_in_bit(inputs, DOUT, COUNT, acc);
+		}
+		delayMicroseconds(1);
+	}
+
+	#if defined(ARDUINO_ARCH_ESP32)
+	portEXIT_CRITICAL(&mux);
+	#else
+	interrupts();
+	#endif
+
+	for (byte i = 0; i < COUNT; i++) {
+		values[i] = sign_extend(acc[i]);
+	}
+	return true;
+}
+
+bool HX711Multi::read_tared(long* values, unsigned long timeout_ms) {
+	if (!read(values, timeout_ms)) {
+		return false;
+	}
+	for (byte i = 0; i < COUNT; i++) {
+		values[i] -= OFFSET[i];
+	}
+	return true;
+}
+
+void HX711Multi::tare(byte times) {
+	long sum[HX711_MULTI_MAX] = { 0 };
+	long values[HX711_MULTI_MAX];
+	byte taken = 0;
+	for (byte t = 0; t < times; t++) {
+		if (!read(values)) {
+			continue;
+		}
+		for (byte i = 0; i < COUNT; i++) {
+			sum[i] += values[i];
+		}
+		taken++;
+	}
+	if (taken == 0) {
+		return;
+	}
+	for (byte i = 0; i < COUNT; i++) {
+		OFFSET[i] = sum[i] / taken;
+	}
+}
+
+void HX711Multi::set_offset(byte channel, long offset) {
+	if (channel < COUNT) {
+		OFFSET[channel] = offset;
+	}
+}
+
+long HX711Multi::get_offset(byte channel) {
+	return channel < COUNT ? OFFSET[channel] : 0;
+}
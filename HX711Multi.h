@@ -0,0 +1,71 @@
+/**
+ *
+ * Synchronized reader for several HX711 chips sharing one PD_SCK line.
+ *
+ * Every chip gets its own DOUT pin, but all of them are clocked by the same
+ * PD_SCK burst. On each clock pulse the input register is sampled once and one
+ * bit is appended to every channel, so N load cells cost a single 25-27 pulse
+ * burst and a single critical section, and the N readings come from the same
+ * conversion cycle.
+ *
+**/
+#ifndef HX711Multi_h
+#define HX711Multi_h
+
+#include <Arduino.h>
+
+// Maximum number of chips on one shared clock
+#define HX711_MULTI_MAX 8
+
+class HX711Multi
+{
+	private:
+		byte COUNT;				// number of channels
+		byte DOUT[HX711_MULTI_MAX];	// data pins, one per chip
+		byte PD_SCK;			// shared clock pin
+		byte GAIN;				// extra pulses selecting gain/channel of the next conversion
+		long OFFSET[HX711_MULTI_MAX] = { 0 };
+		unsigned long LAST_READ_US = 0;
+
+		uint64_t read_inputs();
+		void clock(bool high);
+
+	public:
+
+		// count: number of chips; dout: their DOUT pins; pd_sck: shared clock; gain as in HX711::set_gain()
+		HX711Multi(byte count, const byte* dout, byte pd_sck, byte gain = 128);
+
+		void begin();
+
+		byte channels() const { return COUNT; }
+
+		// all chips must have a conversion ready before the shared burst can start
+		bool is_ready();
+
+		// wait (up to timeout_ms) for every chip, then clock all of them out in one burst.
+		// values must hold channels() entries. Returns false on timeout.
+		bool read(long* values, unsigned long timeout_ms = 1000);
+
+		// same as read(), minus each channel's OFFSET
+		bool read_tared(long* values, unsigned long timeout_ms = 1000);
+
+		// micros() at the start of the last burst: the common timestamp of all channels
+		unsigned long last_read_us() const { return LAST_READ_US; }
+
+		void set_gain(byte gain = 128);
+
+		// set every channel's OFFSET from an average of `times` readings
+		void tare(byte times = 10);
+
+		void set_offset(byte channel, long offset);
+		long get_offset(byte channel);
+
+		// Append the bit seen on each channel's DOUT pin to its accumulator.
+		// inputs is the pin level bitmap (bit n = GPIO n) sampled on one clock pulse.
+		static void shift_in_bit(uint64_t inputs, const byte* dout, byte count, uint32_t* acc);
+
+		// Sign-extend a 24-bit two's complement word
+		static long sign_extend(uint32_t raw);
+};
+
+#endif /* HX711Multi_h */
@@ -0,0 +1,56 @@
+/**
+ * @file HX711_SPI.cpp
+ * @brief Implementación del backend SPI para el HX711.
+ */
+#include "HX711_SPI.h"
+
+HX711SpiBackend::HX711SpiBackend(uint8_t bus, uint32_t freq)
+  : spi(bus), freq(freq) {}
+
+/**
+ * @brief Asigna PD_SCK a SCLK y DOUT a MISO mediante la matriz GPIO.
+ * MOSI y CS no se usan.
+ */
+void HX711SpiBackend::begin(byte dout, byte pd_sck) {
+  DOUT = dout;
+  PD_SCK = pd_sck;
+  spi.begin(PD_SCK, DOUT, -1, -1);
+}
+
+/**
+ * @brief El pad de DOUT sigue siendo legible por GPIO aunque esté enrutado a MISO.
+ */
+bool HX711SpiBackend::is_ready() {
+  return digitalRead(DOUT) == LOW;
+}
+
+/**
+ * @brief Lee 24 bits de datos + pulsos de ganancia en una única transacción.
+ *
+ * SPI modo 1: reloj en reposo bajo, el HX711 saca el bit en el flanco de subida y
+ * el periférico lo muestrea en el de bajada. Con MSBFIRST, transferBits() devuelve
+ * los bits recibidos alineados a la izquierda en la palabra de 32 bits, de modo que
+ * los 24 bits de datos quedan en la parte alta y los pulsos de ganancia debajo.
+ */
+uint32_t HX711SpiBackend::read_raw(byte gain_pulses) {
+  uint32_t rx = 0;
+  spi.beginTransaction(SPISettings(freq, MSBFIRST, SPI_MODE1));
+  spi.transferBits(0, &rx, 24 + gain_pulses);
+  spi.endTransaction();
+  return rx >> 8;
+}
+
+/**
+ * @brief Fuerza PD_SCK a un nivel estático (power down / power up).
+ * Para ello se libera el pin del periférico y se vuelve a enrutar al despertar.
+ */
+void HX711SpiBackend::set_clock(bool high) {
+  if (high) {
+    spi.end();
+    pinMode(PD_SCK, OUTPUT);
+    digitalWrite(PD_SCK, HIGH);
+  } else {
+    digitalWrite(PD_SCK, LOW);
+    spi.begin(PD_SCK, DOUT, -1, -1);
+  }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file HX711_SPI.h
+ * @brief Backend del HX711 que genera la ráfaga de PD_SCK con un periférico SPI del ESP32-S3.
+ *
+ * PD_SCK se conecta como SCLK y DOUT como MISO. El periférico emite los 25-27
+ * pulsos de reloj y muestrea DOUT en cada flanco de bajada (SPI modo 1), así que
+ * la CPU no conmuta ningún bit y no hace falta sección crítica: una interrupción
+ * ya no puede estirar un pulso por encima de los 60 us que apagan el chip.
+ */
+#pragma once
+#include <Arduino.h>
+#include <SPI.h>
+#include "HX711.h"
+
+/** Frecuencia de PD_SCK. El HX711 admite pulsos de hasta 0.2 us en alto/bajo. */
+#define HX711_SPI_FREQ 1000000
+
+/**
+ * @brief Transporte HX711 sobre SPI hardware.
+ *
+ * Uso:
+ *   HX711SpiBackend spiBackend;
+ *   hx711.set_backend(&spiBackend);
+ *   hx711.begin(DOUT, SCK);
+ *
+ * El LCD ocupa FSPI, por eso por defecto se usa el bus HSPI (SPI3).
+ */
+class HX711SpiBackend : public HX711Backend {
+public:
+    /** @param bus Bus SPI del ESP32-S3 (FSPI o HSPI). @param freq Frecuencia de PD_SCK en Hz. */
+    HX711SpiBackend(uint8_t bus = HSPI, uint32_t freq = HX711_SPI_FREQ);
+
+    void begin(byte dout, byte pd_sck) override;
+    bool is_ready() override;
+    uint32_t read_raw(byte gain_pulses) override;
+    void set_clock(bool high) override;
+
+private:
+    SPIClass spi;
+    uint32_t freq;
+    byte DOUT = 0;
+    byte PD_SCK = 0;
+};
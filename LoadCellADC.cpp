@@ -0,0 +1,141 @@
+/**
+ *
+ * Generic load-cell ADC driver interface.
+ * Offset/scale handling and the averaging helpers are shared by every driver;
+ * they only rely on read() and is_ready().
+ *
+**/
+#include <Arduino.h>
+#include "LoadCellADC.h"
+
+LoadCellADC::~LoadCellADC() {
+}
+
+long LoadCellADC::read_average(byte times) {
+	long sum = 0;
+	byte valid = 0;
+	for (byte i = 0; i < times; i++) {
+		long value = read();
+		if (value != READ_FAILED) {
+			sum += value;
+			valid++;
+		}
+		// Probably will do no harm on AVR but will feed the Watchdog Timer (WDT) on ESP.
+		// https://github.com/bogde/HX711/issues/73
+		delay(0);
+	}
+	return valid ? sum / valid : READ_FAILED;
+}
+
+double LoadCellADC::get_value(byte times) {
+	return read_average(times) - OFFSET;
+}
+
+long LoadCellADC::read_tared() {
+	long value = read();
+	return value == READ_FAILED ? READ_FAILED : value - OFFSET;
+}
+
+float LoadCellADC::get_units(byte times) {
+	return get_value(times) / SCALE;
+}
+
+void LoadCellADC::tare(byte times) {
+	long average = read_average(times);
+	if (average != READ_FAILED) {
+		set_offset(average);
+	}
+}
+
+void LoadCellADC::push_window(long value) {
+	#if defined(ARDUINO_ARCH_ESP32)
+	portENTER_CRITICAL(&WINDOW_MUX);
+	#endif
+
+	// Replace the oldest reading once the window is full
+	if (WINDOW_COUNT == WINDOW_SIZE) {
+		WINDOW_SUM -= WINDOW[WINDOW_POS];
+	} else {
+		WINDOW_COUNT++;
+	}
+	WINDOW[WINDOW_POS] = value;
+	WINDOW_SUM += value;
+	WINDOW_POS = (WINDOW_POS + 1) % WINDOW_SIZE;
+
+	#if defined(ARDUINO_ARCH_ESP32)
+	portEXIT_CRITICAL(&WINDOW_MUX);
+	#endif
+}
+
+void LoadCellADC::set_window(byte size) {
+	if (size < 1) size = 1;
+	if (size > LOADCELL_WINDOW_MAX) size = LOADCELL_WINDOW_MAX;
+
+	#if defined(ARDUINO_ARCH_ESP32)
+	portENTER_CRITICAL(&WINDOW_MUX);
+	#endif
+	WINDOW_SIZE = size;
+	WINDOW_COUNT = 0;
+	WINDOW_POS = 0;
+	WINDOW_SUM = 0;
+	#if defined(ARDUINO_ARCH_ESP32)
+	portEXIT_CRITICAL(&WINDOW_MUX);
+	#endif
+}
+
+void LoadCellADC::reset_window() {
+	set_window(WINDOW_SIZE);
+}
+
+byte LoadCellADC::window_count() {
+	return WINDOW_COUNT;
+}
+
+bool LoadCellADC::window_full() {
+	return WINDOW_COUNT == WINDOW_SIZE;
+}
+
+long LoadCellADC::read_window_average() {
+	#if defined(ARDUINO_ARCH_ESP32)
+	portENTER_CRITICAL(&WINDOW_MUX);
+	#endif
+	long sum = WINDOW_SUM;
+	byte count = WINDOW_COUNT;
+	#if defined(ARDUINO_ARCH_ESP32)
+	portEXIT_CRITICAL(&WINDOW_MUX);
+	#endif
+
+	return count ? sum / count : 0;
+}
+
+double LoadCellADC::get_value_window() {
+	return read_window_average() - OFFSET;
+}
+
+float LoadCellADC::get_units_window() {
+	return get_value_window() / SCALE;
+}
+
+bool LoadCellADC::tare_window() {
+	if (!window_full()) {
+		return false;
+	}
+	set_offset(read_window_average());
+	return true;
+}
+
+void LoadCellADC::set_scale(float scale) {
+	SCALE = scale;
+}
+
+float LoadCellADC::get_scale() {
+	return SCALE;
+}
+
+void LoadCellADC::set_offset(long offset) {
+	OFFSET = offset;
+}
+
+long LoadCellADC::get_offset() {
+	return OFFSET;
+}
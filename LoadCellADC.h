@@ -0,0 +1,127 @@
+/**
+ *
+ * Generic load-cell ADC driver interface.
+ *
+ * Every 24-bit bridge ADC used for the brake (HX711, NAU7802, ...) implements
+ * begin() / is_ready() / read(). Tare, scale and the averaging helpers, both the
+ * blocking ones inherited from the HX711 library and the streaming window, are
+ * implemented once here on top of those.
+ *
+**/
+#ifndef LoadCellADC_h
+#define LoadCellADC_h
+
+#if ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// Capacity of the streaming window (see set_window())
+#define LOADCELL_WINDOW_MAX 32
+
+class LoadCellADC
+{
+	private:
+		long OFFSET = 0;	// used for tare weight
+		float SCALE = 1;	// used to return weight in grams, kg, ounces, whatever
+
+		// Moving window over the latest readings, fed by read(). The running sum makes
+		// averages O(1) and lets callers use samples that are already flowing.
+		long WINDOW[LOADCELL_WINDOW_MAX];
+		long WINDOW_SUM = 0;
+		byte WINDOW_SIZE = 10;
+		byte WINDOW_COUNT = 0;
+		byte WINDOW_POS = 0;
+		#if defined(ARDUINO_ARCH_ESP32)
+		portMUX_TYPE WINDOW_MUX = portMUX_INITIALIZER_UNLOCKED;	// read() may run on the other core
+		#endif
+
+	protected:
+		// drivers call this from read() with every new conversion
+		void push_window(long value);
+
+	public:
+		// returned by read() when no conversion could be fetched (bus error or timeout);
+		// it lies outside the 24-bit range and never enters the window
+		static const long READ_FAILED = -0x7FFFFFFFL - 1;
+
+		virtual ~LoadCellADC();
+
+		// Configure the pins/bus and start conversions; returns false if the device does not answer
+		virtual bool begin() = 0;
+
+		// true when a new conversion can be read without waiting
+		virtual bool is_ready() = 0;
+
+		// waits for the chip to be ready and returns a signed 24-bit reading, or READ_FAILED
+		virtual long read() = 0;
+
+		// nominal conversion rate in samples per second
+		virtual uint16_t sample_rate() = 0;
+
+		// pin whose `ready_edge()` signals a new conversion, or -1 if readiness must be polled
+		virtual int ready_pin() { return -1; }
+		virtual int ready_edge() { return FALLING; }
+
+		// CPU cycles spent transferring the last reading (0 if not measured)
+		virtual uint32_t get_read_cycles() { return 0; }
+
+		// returns an average reading; times = how many times to read. Failed reads are
+		// left out of the average; READ_FAILED if every one of them failed
+		long read_average(byte times = 10);
+
+		// returns (read_average() - OFFSET), that is the current value without the tare weight; times = how many readings to do
+		double get_value(byte times = 1);
+
+		// waits for the chip to be ready and returns (read() - OFFSET) using integer math only;
+		// READ_FAILED if the read failed
+		long read_tared();
+
+		// returns get_value() divided by SCALE, that is the raw value divided by a value obtained via calibration
+		// times = how many readings to do
+		float get_units(byte times = 1);
+
+		// set the OFFSET value for tare weight; times = how many times to read the tare value.
+		// OFFSET is left unchanged if no reading succeeded
+		void tare(byte times = 10);
+
+		// Non-blocking equivalents, computed from the streaming window of recent readings.
+		// Every call to read() (directly or through the functions above) feeds the window.
+
+		// set the window length (1..LOADCELL_WINDOW_MAX readings); clears the window
+		void set_window(byte size = 10);
+
+		// drop all readings held in the window
+		void reset_window();
+
+		// number of readings currently in the window, and whether it holds `size` readings
+		byte window_count();
+		bool window_full();
+
+		// average of the readings in the window; 0 if it is empty
+		long read_window_average();
+
+		// returns (read_window_average() - OFFSET) without waiting for the chip
+		double get_value_window();
+
+		// returns get_value_window() divided by SCALE
+		float get_units_window();
+
+		// set OFFSET from the window average; returns false (OFFSET unchanged) until the window is full
+		bool tare_window();
+
+		// set the SCALE value; this value is used to convert the raw data to "human readable" data (measure units)
+		void set_scale(float scale = 1.f);
+
+		// get the current SCALE
+		float get_scale();
+
+		// set OFFSET, the value that's subtracted from the actual reading (tare weight)
+		void set_offset(long offset = 0);
+
+		// get the current OFFSET
+		long get_offset();
+};
+
+#endif /* LoadCellADC_h */
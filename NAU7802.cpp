@@ -0,0 +1,235 @@
+/**
+ *
+ * NAU7802 24-bit load-cell ADC driver (I2C, up to 320 SPS).
+ *
+**/
+#include <Arduino.h>
+#include "NAU7802.h"
+
+// Register map (see the NAU7802 datasheet)
+#define NAU7802_PU_CTRL		0x00
+#define NAU7802_CTRL1		0x01
+#define NAU7802_CTRL2		0x02
+#define NAU7802_ADCO_B2		0x12
+#define NAU7802_ADC		0x15
+#define NAU7802_POWER		0x1C
+
+// PU_CTRL bits
+#define PU_CTRL_RR		0	// register reset
+#define PU_CTRL_PUD		1	// power up digital
+#define PU_CTRL_PUA		2	// power up analog
+#define PU_CTRL_PUR		3	// power up ready
+#define PU_CTRL_CS		4	// cycle start
+#define PU_CTRL_CR		5	// cycle ready
+#define PU_CTRL_AVDDS	7	// AVDD source: internal LDO
+
+// CTRL1 fields
+#define CTRL1_GAIN_MASK	0x07
+#define CTRL1_VLDO_MASK	0x38
+#define CTRL1_VLDO_3V3	(4 << 3)
+
+// CTRL2 fields
+#define CTRL2_CALS		2	// start calibration
+#define CTRL2_CAL_ERR	3	// calibration error
+#define CTRL2_CRS_MASK	0x70
+
+// ADC register: disable the clock chopper (recommended setting)
+#define ADC_CHPS_OFF	0x30
+
+// POWER register: decoupling capacitor on channel 2 input
+#define POWER_PGA_CAP_EN	7
+
+NAU7802WireBus::NAU7802WireBus(TwoWire& wire, int sda, int scl, uint32_t clock, byte address)
+	: wire(wire), SDA_PIN(sda), SCL_PIN(scl), CLOCK(clock), ADDRESS(address) {
+}
+
+bool NAU7802WireBus::begin() {
+	if (!wire.begin(SDA_PIN, SCL_PIN, CLOCK)) {
+		return false;
+	}
+	// Probe the address
+	wire.beginTransmission(ADDRESS);
+	return wire.endTransmission() == 0;
+}
+
+bool NAU7802WireBus::write_reg(byte reg, byte value) {
+	wire.beginTransmission(ADDRESS);
+	wire.write(reg);
+	wire.write(value);
+	return wire.endTransmission() == 0;
+}
+
+bool NAU7802WireBus::read_regs(byte reg, byte* buf, byte len) {
+	wire.beginTransmission(ADDRESS);
+	wire.write(reg);
+	if (wire.endTransmission(false) != 0) {
+		return false;
+	}
+	if (wire.requestFrom((uint16_t)ADDRESS, (size_t)len, true) != len) {
+		return false;
+	}
+	for (byte i = 0; i < len; i++) {
+		buf[i] = wire.read();
+	}
+	return true;
+}
+
+
+NAU7802::NAU7802(NAU7802Bus& bus, Rate rate, int drdy_pin, byte gain)
+	: bus(bus), RATE(rate), DRDY_PIN(drdy_pin), GAIN(gain) {
+}
+
+NAU7802::~NAU7802() {
+}
+
+bool NAU7802::set_bits(byte reg, byte mask, byte value) {
+	byte current;
+	if (!bus.read_regs(reg, &current, 1)) {
+		return false;
+	}
+	return bus.write_reg(reg, (current & ~mask) | (value & mask));
+}
+
+bool NAU7802::get_bit(byte reg, byte bit, bool& value) {
+	byte current;
+	if (!bus.read_regs(reg, &current, 1)) {
+		return false;
+	}
+	value = current & (1 << bit);
+	return true;
+}
+
+bool NAU7802::begin() {
+	if (!bus.begin()) {
+		return false;
+	}
+	if (DRDY_PIN >= 0) {
+		pinMode(DRDY_PIN, INPUT);
+	}
+
+	// Register reset, then power up the digital section and wait for it
+	bool ok = bus.write_reg(NAU7802_PU_CTRL, 1 << PU_CTRL_RR);
+	ok &= bus.write_reg(NAU7802_PU_CTRL, 1 << PU_CTRL_PUD);
+	unsigned long started = millis();
+	bool powered = false;
+	while (!get_bit(NAU7802_PU_CTRL, PU_CTRL_PUR, powered) || !powered) {
+		if (millis() - started > 100) {
+			return false;
+		}
+		delay(1);
+	}
+
+	// Analog section on, AVDD from the internal LDO
+	ok &= set_bits(NAU7802_PU_CTRL, (1 << PU_CTRL_PUA) | (1 << PU_CTRL_AVDDS), (1 << PU_CTRL_PUA) | (1 << PU_CTRL_AVDDS));
+
+	// LDO at 3.3 V and PGA gain (encoded as log2(gain))
+	byte gain_code = 0;
+	while (gain_code < 7 && (1 << gain_code) < GAIN) {
+		gain_code++;
+	}
+	ok &= set_bits(NAU7802_CTRL1, CTRL1_VLDO_MASK | CTRL1_GAIN_MASK, CTRL1_VLDO_3V3 | gain_code);
+
+	// Conversion rate
+	ok &= set_bits(NAU7802_CTRL2, CTRL2_CRS_MASK, RATE << 4);
+
+	// Recommended analog settings: clock chopper off, PGA output capacitor on
+	ok &= set_bits(NAU7802_ADC, ADC_CHPS_OFF, ADC_CHPS_OFF);
+	ok &= set_bits(NAU7802_POWER, 1 << POWER_PGA_CAP_EN, 1 << POWER_PGA_CAP_EN);
+
+	ok &= calibrate_afe();
+
+	// Start conversions
+	ok &= set_bits(NAU7802_PU_CTRL, 1 << PU_CTRL_CS, 1 << PU_CTRL_CS);
+	return ok;
+}
+
+bool NAU7802::calibrate_afe() {
+	if (!set_bits(NAU7802_CTRL2, 1 << CTRL2_CALS, 1 << CTRL2_CALS)) {
+		return false;
+	}
+	unsigned long started = millis();
+	bool busy = true;
+	while (busy) {
+		if (!get_bit(NAU7802_CTRL2, CTRL2_CALS, busy)) {
+			return false;
+		}
+		if (busy) {
+			if (millis() - started > 1000) {
+				return false;
+			}
+			delay(1);
+		}
+	}
+	bool failed = true;
+	return get_bit(NAU7802_CTRL2, CTRL2_CAL_ERR, failed) && !failed;
+}
+
+bool NAU7802::is_ready() {
+	if (DRDY_PIN >= 0) {
+		return digitalRead(DRDY_PIN) == HIGH;
+	}
+	// a failed bus read counts as not ready
+	bool ready = false;
+	return get_bit(NAU7802_PU_CTRL, PU_CTRL_CR, ready) && ready;
+}
+
+long NAU7802::read() {
+	// Wait for the chip to become ready, feeding the watchdog like HX711::wait_ready().
+	// Give up after two conversion periods: a chip that stopped answering costs one sample.
+	unsigned long timeout_us = 2000000UL / sample_rate();
+	unsigned long started = micros();
+	while (!is_ready()) {
+		if (micros() - started > timeout_us) {
+			return READ_FAILED;
+		}
+		delay(0);
+	}
+
+	byte data[3];
+	#if defined(ARDUINO_ARCH_ESP32)
+	uint32_t start = ESP.getCycleCount();
+	bool ok = bus.read_regs(NAU7802_ADCO_B2, data, 3);
+	READ_CYCLES = ESP.getCycleCount() - start;
+	#else
+	bool ok = bus.read_regs(NAU7802_ADCO_B2, data, 3);
+	#endif
+	if (!ok) {
+		return READ_FAILED;
+	}
+
+	uint32_t raw = static_cast<uint32_t>(data[0]) << 16
+			| static_cast<uint32_t>(data[1]) << 8
+			| static_cast<uint32_t>(data[2]);
+
+	// Replicate the most significant bit to pad out a 32-bit signed integer
+	if (raw & 0x800000) {
+		raw |= 0xFF000000;
+	}
+
+	long value = static_cast<long>(static_cast<int32_t>(raw));
+	push_window(value);
+	return value;
+}
+
+uint16_t NAU7802::sample_rate() {
+	switch (RATE) {
+		case SPS_10: return 10;
+		case SPS_20: return 20;
+		case SPS_40: return 40;
+		case SPS_80: return 80;
+		case SPS_320: return 320;
+	}
+	return 0;
+}
+
+int NAU7802::ready_pin() {
+	return DRDY_PIN;
+}
+
+int NAU7802::ready_edge() {
+	return RISING;
+}
+
+uint32_t NAU7802::get_read_cycles() {
+	return READ_CYCLES;
+}
@@ -0,0 +1,105 @@
+/**
+ *
+ * NAU7802 24-bit load-cell ADC driver (I2C, up to 320 SPS).
+ *
+ * Implements LoadCellADC so it can replace the HX711 on the brake. Register access
+ * goes through NAU7802Bus; NAU7802WireBus talks to the chip over TwoWire, and a
+ * mock bus can stand in for it when testing off-target.
+ *
+**/
+#ifndef NAU7802_h
+#define NAU7802_h
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "LoadCellADC.h"
+
+// Register-level transport for the NAU7802
+class NAU7802Bus
+{
+	public:
+		virtual ~NAU7802Bus() {}
+
+		// prepare the bus; returns false if it cannot be started
+		virtual bool begin() { return true; }
+
+		// write one register; returns false if the chip did not acknowledge
+		virtual bool write_reg(byte reg, byte value) = 0;
+
+		// read `len` consecutive registers starting at `reg`
+		virtual bool read_regs(byte reg, byte* buf, byte len) = 0;
+};
+
+// NAU7802Bus over an Arduino TwoWire instance
+class NAU7802WireBus : public NAU7802Bus
+{
+	private:
+		TwoWire& wire;
+		int SDA_PIN;
+		int SCL_PIN;
+		uint32_t CLOCK;
+		byte ADDRESS;
+
+	public:
+		static const byte DEFAULT_ADDRESS = 0x2A;
+
+		NAU7802WireBus(TwoWire& wire, int sda = -1, int scl = -1, uint32_t clock = 400000, byte address = DEFAULT_ADDRESS);
+
+		bool begin() override;
+		bool write_reg(byte reg, byte value) override;
+		bool read_regs(byte reg, byte* buf, byte len) override;
+};
+
+class NAU7802 : public LoadCellADC
+{
+	public:
+		// conversion rates, as encoded in CTRL2.CRS
+		enum Rate : byte {
+			SPS_10 = 0,
+			SPS_20 = 1,
+			SPS_40 = 2,
+			SPS_80 = 3,
+			SPS_320 = 7,
+		};
+
+		// bus: register transport; rate: conversion rate; drdy_pin: GPIO wired to DRDY, or -1 to poll PU_CTRL.CR;
+		// gain: PGA gain, 1..128 in powers of two
+		NAU7802(NAU7802Bus& bus, Rate rate = SPS_320, int drdy_pin = -1, byte gain = 128);
+
+		virtual ~NAU7802();
+
+		// reset, power up the analog and digital sections, select the internal 3.3 V LDO,
+		// set gain and rate, run the internal offset calibration and start conversions
+		bool begin() override;
+
+		// DRDY pin if wired, otherwise the cycle-ready bit of PU_CTRL
+		bool is_ready() override;
+
+		// waits up to two conversion periods for the chip and returns a signed 24-bit reading;
+		// READ_FAILED on timeout or if the I2C transfer fails
+		long read() override;
+
+		uint16_t sample_rate() override;
+
+		// DRDY rises when a conversion is ready
+		int ready_pin() override;
+		int ready_edge() override;
+
+		uint32_t get_read_cycles() override;
+
+		// run the analog front-end offset calibration; needed after changing gain or rate
+		bool calibrate_afe();
+
+	private:
+		NAU7802Bus& bus;
+		Rate RATE;
+		int DRDY_PIN;
+		byte GAIN;
+		uint32_t READ_CYCLES = 0;
+
+		bool set_bits(byte reg, byte mask, byte value);
+		// false if the register could not be read; `value` is then left untouched
+		bool get_bit(byte reg, byte bit, bool& value);
+};
+
+#endif /* NAU7802_h */
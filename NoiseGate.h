@@ -0,0 +1,81 @@
+/**
+ * @file NoiseGate.h
+ * @brief Histéresis adaptativa por pedal: el umbral de cambio sigue al ruido medido.
+ *
+ * Sustituye al CHANGE_THRESHOLD fijo. Estima la desviación típica del ruido
+ * y solo deja pasar un nuevo valor cuando se aleja del último publicado más de
+ * K veces esa estimación. Un pedal limpio responde desde 1 cuenta; uno ruidoso
+ * no provoca informes HID constantes.
+ *
+ * El ruido se mide con la segunda diferencia |x[n] - 2x[n-1] + x[n-2]|, que es
+ * nula para un movimiento a velocidad constante y vale ~2 sigma en media para
+ * ruido blanco: mover el pedal no sube el umbral. Además cada medida se recorta
+ * a 2x la estimación actual, así que una aceleración brusca tampoco la dispara
+ * (el ruido real puede crecer, duplicándose como mucho por constante de tiempo).
+ * En los extremos (0 y fondo de escala) el valor se publica siempre, para que el
+ * pedal suelto llegue exactamente a 0. Todo es aritmética entera.
+ */
+#pragma once
+#include <Arduino.h>
+
+class NoiseGate {
+public:
+    static constexpr uint8_t NOISE_FRAC = 8;  // Bits fraccionarios de la estimación (Q8)
+    static constexpr uint8_t NOISE_SHIFT = 5; // Constante de tiempo de la estimación: 2^5 muestras
+    static constexpr uint8_t K_Q4 = 3 << 4;   // Umbral = 3 sigma
+
+    /** Umbral mínimo (cuentas) y fondo de escala del valor que se vigila. */
+    void begin(int32_t minThreshold, int32_t fullScale) {
+        minimum = minThreshold > 0 ? minThreshold : 1;
+        scale = fullScale;
+        primed = false;
+        noiseQ = 0;
+    }
+
+    /**
+     * @brief Alimenta un nuevo valor.
+     * @param x    Valor actual.
+     * @param held Último valor publicado; se actualiza si el cambio supera el umbral.
+     * @return true si `held` ha cambiado.
+     */
+    bool update(int32_t x, int32_t& held) {
+        if (!primed) {
+            primed = true;
+            prev = prev2 = x;
+            held = x;
+            return true;
+        }
+
+        // Sigma ~ |segunda diferencia| / 2, recortada a 2x la estimación + 1 cuenta
+        uint32_t dQ = (uint32_t)abs(x - 2 * prev + prev2) << (NOISE_FRAC - 1);
+        prev2 = prev;
+        prev = x;
+        const uint32_t capQ = (noiseQ << 1) + (1u << NOISE_FRAC);
+        if (dQ > capQ) dQ = capQ;
+        noiseQ += ((int32_t)dQ - (int32_t)noiseQ) >> NOISE_SHIFT;
+
+        const bool atEnd = (x <= 0 || x >= scale) && x != held;
+        if (atEnd || abs(x - held) > threshold()) {
+            held = x;
+            return true;
+        }
+        return false;
+    }
+
+    /** Ruido estimado (desviación típica aproximada) en cuentas. */
+    int32_t noise() const { return (noiseQ + (1 << (NOISE_FRAC - 1))) >> NOISE_FRAC; }
+
+    /** Umbral de cambio actual en cuentas. */
+    int32_t threshold() const {
+        const int32_t t = (int32_t)((noiseQ * K_Q4) >> (NOISE_FRAC + 4));
+        return t > minimum ? t : minimum;
+    }
+
+private:
+    int32_t minimum = 1;
+    int32_t scale = 0;
+    int32_t prev = 0;
+    int32_t prev2 = 0;
+    uint32_t noiseQ = 0; // Q8
+    bool primed = false;
+};
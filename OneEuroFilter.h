@@ -0,0 +1,91 @@
+/**
+ * @file OneEuroFilter.h
+ * @brief Filtro One Euro (corte adaptativo a la velocidad) en punto fijo para los pedales.
+ *
+ * Un EMA fijo obliga a elegir: mucho suavizado quita el temblor en reposo pero
+ * retrasa los pisotones rápidos. El One Euro sube la frecuencia de corte con la
+ * velocidad del pedal: fc = minCutoff + beta * |velocidad|. En reposo filtra a
+ * minCutoff y en un movimiento rápido casi no añade retardo.
+ *
+ * La velocidad se mide en recorridos completos por segundo (independiente de la
+ * resolución del eje) y se suaviza con un paso bajo fijo de D_CUTOFF_DECIHZ.
+ * Los dos pasos bajo son EmaFilter, así que el dt real entre muestras entra igual
+ * que en el modo EMA. Parámetros enteros: minCutoff en décimas de Hz y beta en
+ * milésimas de Hz por (recorrido/s).
+ */
+#pragma once
+#include <Arduino.h>
+#include "EmaFilter.h"
+
+class OneEuroFilter {
+public:
+    static constexpr uint32_t D_CUTOFF_DECIHZ = 10;      // Corte del paso bajo de la velocidad: 1 Hz
+    static constexpr uint32_t MAX_CUTOFF_DECIHZ = 5000;  // Techo de fc (500 Hz): ya equivale a no filtrar
+    static constexpr int32_t MAX_SPEED = 1 << 21;        // Cuentas/s; acota la velocidad para el estado en Q8
+    static constexpr uint8_t BETA_SHIFT = 24;            // Precisión de la escala de beta precalculada
+
+    /**
+     * @brief Configura el filtro para valores en 0..fullScale.
+     * @param minCutoffDeciHz Corte en reposo, en décimas de Hz (mínimo 0.1 Hz).
+     * @param betaMilli       Aumento del corte, en milésimas de Hz por recorrido/s.
+     */
+    void configure(uint16_t minCutoffDeciHz, uint16_t betaMilli, int32_t fullScale) {
+        minCutoff = minCutoffDeciHz ? minCutoffDeciHz : 1;
+        if (fullScale < 1) fullScale = 1;
+        // fc (décimas de Hz) += velocidad (cuentas/s) * betaMilli / (100 * fullScale)
+        betaQ = ((uint64_t)betaMilli << BETA_SHIFT) / (100u * (uint32_t)fullScale);
+        speed.setTauUs(EmaFilter::tauForDeciHz(D_CUTOFF_DECIHZ));
+        position.setTauUs(EmaFilter::tauForDeciHz(minCutoff));
+        cutoff = minCutoff;
+    }
+
+    /** Activa o desactiva el filtro; desactivado deja pasar el valor y sigue a la entrada. */
+    void setEnabled(bool on) { enabled = on; }
+
+    /** Coloca el filtro en un valor, en reposo; el siguiente dt se mide desde `nowUs`. */
+    void reset(int32_t v, uint32_t nowUs) {
+        primed = true;
+        lastUs = nowUs;
+        speed.reset(0, nowUs);
+        position.reset(v, nowUs);
+    }
+
+    /** Alimenta una muestra tomada en `nowUs` (micros()) y devuelve la salida redondeada. */
+    inline int32_t update(int32_t x, uint32_t nowUs) {
+        if (!primed || !enabled) {
+            reset(x, nowUs); // Desactivado: al volver a activarlo arranca sin salto
+            return x;
+        }
+        const uint32_t dt = nowUs - lastUs;
+        if (dt == 0) return position.value(); // Misma marca de tiempo: sin velocidad que medir
+        lastUs = nowUs;
+
+        // Velocidad frente a la última salida, en cuentas/s
+        int64_t v = (int64_t)(x - position.value()) * 1000000 / (int64_t)dt;
+        if (v > MAX_SPEED) v = MAX_SPEED;
+        if (v < -MAX_SPEED) v = -MAX_SPEED;
+        const int32_t s = abs(speed.update((int32_t)v, nowUs));
+
+        uint64_t fc = minCutoff + (((uint64_t)s * betaQ) >> BETA_SHIFT);
+        if (fc > MAX_CUTOFF_DECIHZ) fc = MAX_CUTOFF_DECIHZ;
+        cutoff = (uint16_t)fc;
+        position.setTauUs(EmaFilter::tauForDeciHz(cutoff));
+        return position.update(x, nowUs);
+    }
+
+    /** Última salida, redondeada a cuentas enteras. */
+    int32_t value() const { return position.value(); }
+
+    /** Frecuencia de corte usada en la última muestra, en décimas de Hz. */
+    uint16_t currentCutoff() const { return cutoff; }
+
+private:
+    EmaFilter position;      // Paso bajo de la señal, corte variable
+    EmaFilter speed;         // Paso bajo de la velocidad, corte fijo
+    uint64_t betaQ = 0;      // betaMilli / (100 * fullScale) en Q24
+    uint32_t lastUs = 0;
+    uint16_t minCutoff = 10; // Décimas de Hz
+    uint16_t cutoff = 10;
+    bool primed = false;
+    bool enabled = true;
+};
@@ -1,14 +1,42 @@
 //#define DEBUG_MODE
+#define BRAKE_HX711_SPI // Reloj del HX711 generado por SPI hardware en lugar de bit-banging
+//#define BRAKE_HX711_FAST // Alternativa: pines constexpr y acceso directo a registros GPIO
+//#define BRAKE_NAU7802 // Célula de carga con NAU7802 (I2C, 320 SPS) en lugar del HX711
+
+#if defined(BRAKE_HX711_SPI) && defined(BRAKE_HX711_FAST)
+#error "Elige solo un backend para el HX711: BRAKE_HX711_SPI o BRAKE_HX711_FAST"
+#endif
+#if defined(BRAKE_NAU7802) && (defined(BRAKE_HX711_SPI) || defined(BRAKE_HX711_FAST))
+#error "BRAKE_NAU7802 sustituye al HX711: desactiva BRAKE_HX711_SPI / BRAKE_HX711_FAST"
+#endif
 
 #include "SimRacing.h"
+#include "AnalogDMA.h"
 #include "USBHIDGamepad.h"
 #include "HX711.h"
+#include "HX711_SPI.h"
+#include "HX711Fast.h"
+#include "NAU7802.h"
+#include "SampleRing.h"
+#include "GlitchRejector.h"
+#include "AutoZero.h"
+#include "AcquisitionStats.h"
+#include "ResponseCurve.h"
+#include "NoiseGate.h"
+#include "EmaFilter.h"
+#include "OneEuroFilter.h"
+#include "AlphaBetaEstimator.h"
+#include "Deadband.h"
+#include "BrakeScale.h"
+#include "FilterChain.h"
 #include "ST7789_Graphics.h"
 #include <Preferences.h>
+#include <stddef.h>
 #include <BLEDevice.h>
 #include <BLEServer.h>
 #include <BLEUtils.h>
 #include <BLE2902.h>
+#include "driver/gpio.h"
 
 // UUIDs para Bluetooth LE (Perfil UART)
 #define SERVICE_UUID           "6E400001-B5A3-F393-E0A9-E50E24DCCA9E"
@@ -21,12 +49,34 @@ static constexpr int Pin_Gas = 4;
 static constexpr int Pin_Clutch = 5;
 static constexpr int LOADCELL_DOUT_PIN = 2;
 static constexpr int LOADCELL_SCK_PIN = 3;
+static constexpr int LOADCELL_DRDY_PIN = -1; // DRDY del NAU7802 (-1 = consultar por I2C). SDA/SCL usan DOUT/SCK
 static constexpr int Pin_Brake = -1; // Usamos HX711, no pin analógico
 
+// Pedales analógicos con los pines fijados en compilación (lectura desenrollada)
+using PedalSet = SimRacing::StaticPedals<Pin_Gas, Pin_Brake, Pin_Clutch>;
+
+// Cadena de filtros de cada pedal, compuesta en compilación (las etapas que no se
+// listan no existen en el binario). EMA y One Euro se conmutan en ejecución con el
+// modo del pedal: la etapa inactiva deja pasar el valor.
+using GasChain = FilterChain<EmaFilter, OneEuroFilter, Deadband>;
+using BrakeChain = FilterChain<EmaFilter, OneEuroFilter, Deadband>;
+using ClutchChain = FilterChain<EmaFilter, OneEuroFilter, Deadband>;
+
 // Constantes para los cálculos
-static constexpr float ADC_brake = 16384.0f;
-static constexpr int ADC_Max = 4095;
-static constexpr uint8_t CHANGE_THRESHOLD = 2;
+static constexpr int32_t ADC_brake = 16384;
+static int ADC_Max = 4095; // Fondo de escala de gas/embrague, se ajusta a la resolución real del ADC en init()
+static constexpr uint32_t ADC_SAMPLE_RATE = 20000; // Conversiones/s del ADC continuo, repartidas entre gas y embrague
+static constexpr uint8_t ADC_OVERSAMPLING_LOG2 = 4; // 16x sobremuestreo -> 14 bits efectivos (12 + 4/2)
+static constexpr uint8_t ADC_NATIVE_BITS = 12;      // Resolución de los valores por defecto y de calibraciones antiguas
+static constexpr bool ADC_LINEARIZE = true;         // Corregir la no linealidad del ADC con la calibración de fábrica (eFuse)
+// La mediana de 3 quita cortes del cursor de una conversión (100 us); los más largos los diluye el sobremuestreo
+static constexpr int ADC_SPIKE_THRESHOLD = 400;     // Salto (códigos de 12 bits) que cuenta como pico del cursor; 0 = sin rechazo
+static constexpr uint8_t CHANGE_THRESHOLD_MIN = 1; // Umbral mínimo de cambio; el real se adapta al ruido de cada pedal
+static constexpr uint8_t BRAKE_WINDOW_SIZE = 8; // Muestras de la célula de carga en la media móvil no bloqueante
+static constexpr bool BRAKE_PREDICT = true;               // Extrapolar el freno entre conversiones (alfa-beta)
+static constexpr uint16_t BRAKE_PREDICT_ALPHA = 26214;    // Ganancia de posición 0.8 (Q15)
+static constexpr uint16_t BRAKE_PREDICT_BETA = 9830;      // Ganancia de velocidad 0.3 (Q15): amortiguamiento crítico para alfa 0.8
+static constexpr int32_t BRAKE_PREDICT_OVERSHOOT = ADC_brake / 32; // Máximo que la predicción se aleja de la última medida (~3%)
 
 // Dirección inicial en la EEPROM para los valores de calibración
 static constexpr int EEPROM_CALIBRATION_START = 0;
@@ -41,12 +91,45 @@ static constexpr int16_t DEFAULT_BRAKE_MAX = 16384;
 static constexpr int16_t DEFAULT_CLUTCH_MIN = 0;
 static constexpr int16_t DEFAULT_CLUTCH_MAX = 4095;
 static constexpr float DEFAULT_BRAKE_MAX_FORCE = 1000000.0f;
-static constexpr uint8_t DEFAULT_FILTER_ALPHA = 0;
+static constexpr uint16_t DEFAULT_FILTER_HZ = 0;     // Frecuencia de corte del filtro; 0 = sin filtro
+static constexpr uint16_t FILTER_MAX_HZ = 200;       // Por encima el filtro ya no hace nada útil
+static constexpr float FILTER_LEGACY_RATE_HZ = 1000.0f; // Tasa de loop() supuesta al migrar el % antiguo
+static constexpr uint8_t FILTER_MODE_EMA = 0;        // Paso bajo de corte fijo (filterHz)
+static constexpr uint8_t FILTER_MODE_ONE_EURO = 1;   // Corte adaptativo a la velocidad del pedal
+static constexpr uint16_t DEFAULT_EURO_MIN_CUTOFF = 10;  // 1 Hz en reposo (décimas de Hz)
+static constexpr uint16_t DEFAULT_EURO_BETA = 2500;      // +2.5 Hz por recorrido/s (milésimas)
+
+// Estado de un pedal dentro de un frame de adquisición
+struct PedalAxis {
+    int32_t raw;        // Lectura cruda: código del ADC (gas/embrague) o célula con tara (freno)
+    int32_t calibrated; // Escalado con la calibración a 0..fondo de escala
+    int32_t filtered;   // Tras el filtro
+    int16_t value;      // Valor enviado por HID (tras la curva de respuesta)
+    bool changed;       // value ha cambiado en este frame
+};
+
+// Instantánea de una pasada de adquisición. Se produce una sola vez en updateAll()
+// y HID, pantalla y telemetría leen de aquí: lo que se reporta es lo que se envió.
+struct PedalFrame {
+    PedalAxis axis[3];       // Indexado por SimRacing::Pedal
+    uint32_t seq;            // Número de frame
+    uint32_t timestamp;      // micros() de la lectura de gas/embrague
+    uint32_t brakeSeq;       // seq de la última muestra del freno incluida
+    uint32_t brakeTimestamp; // micros() del dato listo de esa muestra
+};
+
+// Filtro de un pedal: modo y parámetros del One Euro
+struct PedalFilterConfig {
+    uint8_t mode;       // FILTER_MODE_EMA o FILTER_MODE_ONE_EURO
+    uint16_t minCutoff; // One Euro: corte en reposo (décimas de Hz)
+    uint16_t beta;      // One Euro: aumento del corte con la velocidad (milésimas de Hz por recorrido/s)
+} __attribute__((packed));
 
-// Estructura para mantener el estado de los pedales
-struct PedalState {
-    int16_t value;
-    bool changed;
+// Parámetros por pedal del resto de etapas de la cadena
+struct PedalStageConfig {
+    uint16_t cutoffHz; // EMA: frecuencia de corte (Hz). 0 = Crudo
+    uint8_t deadLow;   // Zona muerta al inicio del recorrido (%)
+    uint8_t deadHigh;  // Zona muerta al final del recorrido (%)
 } __attribute__((packed));
 
 // Estructura para los valores de calibración
@@ -61,18 +144,81 @@ struct AllCalibrationValues {
     CalibrationValues gas;
     CalibrationValues brake;
     CalibrationValues clutch;
-    uint8_t filterAlpha; // Factor de suavizado (0-100%). 0=Crudo, 100=Max Suavizado.
+    uint8_t filterAlpha; // Obsoleto (suavizado en % por iteración); solo se lee al migrar a filterHz
     float brakeMaxForce;  // Fuerza máxima del freno
+    uint8_t adcBits;      // Resolución (bits) con la que se midieron gas/embrague
+    CurvePoints curves[3]; // Curvas de respuesta indexadas por SimRacing::Pedal (gas, freno, embrague)
+    uint16_t filterHz;     // Último corte fijado con 'f' / slider para los tres pedales (Hz). 0 = Crudo
+    PedalFilterConfig pedalFilters[3]; // Modo de filtro por pedal, indexado por SimRacing::Pedal
+    PedalStageConfig pedalStages[3];   // Corte EMA y zonas muertas por pedal, indexado por SimRacing::Pedal
 } __attribute__((packed));
 
 // Variables globales para Tarea FreeRTOS (Core 0)
 TaskHandle_t TaskBrakeHandle = NULL;
-volatile long fb_brake_raw = 0; // fb = framebuffer type (shared)
-volatile bool fb_brake_ready = false;
-SemaphoreHandle_t fb_mutex = NULL; // Opcional, pero usaremos atomicidad simple para long en 32bit
+// Cola lock-free Core 0 -> Core 1 con las muestras del freno (fb = framebuffer type (shared))
+static constexpr size_t BRAKE_RING_SIZE = 16;
+SampleRing<LoadCellSample, BRAKE_RING_SIZE> fb_brake_ring;
+GlitchRejector fb_brake_glitch; // Rechazo de saturación / picos, corre en la tarea (Core 0)
+static constexpr uint8_t BRAKE_MAX_SLEW_PER_S = 50; // Velocidad máxima: 50 x brakeMaxForce por segundo (fondo en 20 ms)
+AutoZero fb_brake_zero; // Tara asíncrona + seguimiento de deriva, corre en la tarea (Core 0)
+static constexpr uint8_t BRAKE_TARE_SAMPLES = 10;   // Conversiones para la tara inicial
+static constexpr uint8_t BRAKE_IDLE_BAND_PCT = 2;   // Banda de reposo (% de brakeMaxForce) para seguir la deriva
+AcquisitionStats fb_brake_stats; // Tasa efectiva, jitter, pérdidas y tiempo de lectura (Core 0)
+
+// Adquisición por interrupción: el flanco de bajada de DOUT (dato listo) despierta la tarea
+// en lugar de sondear is_ready() cada tick. false = modo polling clásico.
+static constexpr bool BRAKE_USE_DRDY_IRQ = true;
+static constexpr uint32_t BRAKE_IRQ_TIMEOUT_MS = 200; // Red de seguridad si se pierde un flanco
+
+// Pin de dato listo del ADC de freno con la IRQ armada (-1 = modo polling)
+int fb_brake_drdy_pin = -1;
+
+// Parada cooperativa de la tarea: nunca se borra en mitad de una lectura (dejaría tomado
+// el lock del bus SPI / Wire y la IRQ desactivada). El loop pide la parada, la tarea
+// termina la conversión en curso, rearma la IRQ, la suelta, confirma y se aparca.
+static constexpr uint32_t BRAKE_STOP_TIMEOUT_MS = 2 * BRAKE_IRQ_TIMEOUT_MS + 100;
+volatile bool fb_brake_stop_request = false; // Core 1 -> Core 0
+volatile bool fb_brake_parked = false;       // Core 0 -> Core 1: la tarea está aparcada
 
-// Prototipo de la tarea
+// Retardo entre flanco DOUT (dato listo) y el inicio de la lectura, en microsegundos
+volatile uint32_t fb_brake_ready_us = 0;       // micros() del último flanco de DOUT
+volatile uint32_t fb_brake_latency_us = 0;     // Retardo de la última muestra
+volatile uint32_t fb_brake_latency_max_us = 0; // Máximo desde el último diagnóstico
+volatile uint32_t fb_brake_read_errors = 0;    // Lecturas fallidas (LoadCellADC::READ_FAILED)
+
+// Prototipos de la tarea y su ISR
 void taskBrakeRead(void * parameter);
+void IRAM_ATTR isrBrakeReady();
+
+// Parser JSON mínimo para los comandos de configuración. No valida la estructura:
+// busca "clave" y devuelve un puntero al valor que la sigue (nullptr si no está).
+static const char* jsonValue(const char* json, const char* key) {
+    char pattern[24];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char* p = strstr(json, pattern);
+    if (!p) return nullptr;
+    p += strlen(pattern);
+    while (*p == ' ' || *p == ':') p++;
+    return p;
+}
+
+// Lee un array de enteros 0..255 ("x":[0,50,100]). Devuelve el número de elementos o -1.
+static int jsonIntArray(const char* json, const char* key, uint8_t* out, int maxCount) {
+    const char* p = jsonValue(json, key);
+    if (!p || *p != '[') return -1;
+    p++;
+    int n = 0;
+    while (*p == ' ') p++;
+    while (*p && *p != ']') {
+        char* end;
+        long v = strtol(p, &end, 10);
+        if (end == p || n >= maxCount || v < 0 || v > 255) return -1;
+        out[n++] = (uint8_t)v;
+        p = end;
+        while (*p == ' ' || *p == ',') p++;
+    }
+    return *p == ']' ? n : -1;
+}
 
 // Wrapper para compatibilidad con la librería Joystick nativa de ESP32-S3
 class JoystickWrapper {
@@ -98,7 +244,7 @@ public:
     // Gas -> Ry (Right Trigger)
     void setRyAxis(int16_t v) { _ry = mapJoystick(v, ADC_Max); }
     // Brake -> Rx (Left Trigger)
-    void setRxAxis(int16_t v) { _rx = mapJoystick(v, (int32_t)ADC_brake); }
+    void setRxAxis(int16_t v) { _rx = mapJoystick(v, ADC_brake); }
     // Clutch -> Z (Right Stick Z)
     void setZAxis(int16_t v) { _z = mapJoystick(v, ADC_Max); }
     
@@ -114,17 +260,22 @@ public:
 // Clase para manejar los pedales
 class PedalManager {
 private:
-    SimRacing::ThreePedals& pedals;
-    HX711& brake_pedal;
+    PedalSet& pedals;
+    LoadCellADC& brake_pedal;
     JoystickWrapper& joystick;
     Preferences preferences;
     
-    PedalState gas{0, false};
-    PedalState brake{0, false};
-    PedalState clutch{0, false};
+    PedalFrame frame{}; // Último frame de adquisición, fuente única para HID, pantalla y telemetría
     
     AllCalibrationValues calibration;
-    float brake_scaling_factor;  // Factor de escalado dinámico
+    BrakeScale brakeScale;  // Factor de escalado dinámico ADC_brake / brakeMaxForce
+    ResponseCurve curves[3]; // Curvas compiladas a tabla, indexadas por SimRacing::Pedal
+    NoiseGate gates[3];      // Histéresis adaptativa al ruido, indexada por SimRacing::Pedal
+    GasChain gasChain;       // Cadenas de filtros por pedal
+    BrakeChain brakeChain;
+    ClutchChain clutchChain;
+    AlphaBetaEstimator brakePredictor; // Posición + velocidad del freno para publicar entre conversiones
+    int32_t brakeGated = 0;            // Último valor del freno aceptado por la histéresis (muestras reales)
     
     void calibratePedal(const char* pedalName, CalibrationValues& calib) {
         display.clearScreen(BLACK);
@@ -144,11 +295,13 @@ private:
         
         // Leer valor mínimo (pedal sin presionar)
         if (strcmp(pedalName, "FRENO") == 0) {
-            float rawValue = brake_pedal.get_value();
+            // Media de la ventana que ya alimenta la tarea de freno: no bloquea ni compite por el bus
+            float rawValue = brake_pedal.get_value_window();
             calib.min = (int16_t)rawValue;
         } else {
-            int pin = (strcmp(pedalName, "GAS") == 0) ? Pin_Gas : Pin_Clutch;
-            calib.min = analogRead(pin);
+            SimRacing::Pedal id = (strcmp(pedalName, "GAS") == 0) ? SimRacing::Gas : SimRacing::Clutch;
+            pedals.update();
+            calib.min = pedals.getPositionRaw(id);
         }
         
         display.fillRect(0, 90, 320, 60, BLACK); // Limpiar zona de texto inferior
@@ -162,29 +315,35 @@ private:
         
         // Leer valor máximo (pedal presionado)
         if (strcmp(pedalName, "FRENO") == 0) {
-            // Detener tarea para tener control exclusivo del bus SPI
-            stopBrakeTask();
-            delay(10); // Esperar que termine cualquier lectura
+            // Aparcar la tarea para tener control exclusivo del bus (SPI / I2C)
+            if (!stopBrakeTask()) {
+                // Sin confirmación el bus puede seguir ocupado: no leer, conservar el máximo anterior
+                Serial.println("[ERROR] La tarea del freno no se detiene");
+                startBrakeTask();
+                return;
+            }
             
-            float maxValue = 0;
+            long maxValue = 0;
             Serial.println("Manteniendo presionado el freno, tomando muestras...");
             for(int i = 0; i < 20; i++) {
                 // Bloqueante, queremos precisión aquí
                 while(!brake_pedal.is_ready()) { delay(1); }
-                float currentValue = brake_pedal.get_value();
+                long currentValue = brake_pedal.read_tared();
+                if (currentValue == LoadCellADC::READ_FAILED) continue;
                 maxValue = max(maxValue, currentValue);
                 delay(50);
             }
-            calibration.brakeMaxForce = maxValue;
-            if (calibration.brakeMaxForce < 1000) calibration.brakeMaxForce = 1000; // Evitar div/0 o valores absurdos
-            brake_scaling_factor = ADC_brake / calibration.brakeMaxForce;
+            if (maxValue < 1000) maxValue = 1000; // Evitar div/0 o valores absurdos
+            calibration.brakeMaxForce = (float)maxValue;
+            updateBrakeScale();
             calib.max = ADC_brake;
             
             // Reiniciar tarea
             startBrakeTask();
         } else {
-            int pin = (strcmp(pedalName, "GAS") == 0) ? Pin_Gas : Pin_Clutch;
-            calib.max = analogRead(pin);
+            SimRacing::Pedal id = (strcmp(pedalName, "GAS") == 0) ? SimRacing::Gas : SimRacing::Clutch;
+            pedals.update();
+            calib.max = pedals.getPositionRaw(id);
         }
     }
 
@@ -200,30 +359,145 @@ private:
         size_t len = preferences.getBytes("calib", &calibration, sizeof(AllCalibrationValues));
         preferences.end();
         
+        // Blobs de versiones anteriores: se completan los campos añadidos después
+        if (len == offsetof(AllCalibrationValues, adcBits)) {
+            calibration.adcBits = ADC_NATIVE_BITS; // Gas/embrague se guardaron a 12 bits
+            len = offsetof(AllCalibrationValues, curves);
+        }
+        if (len == offsetof(AllCalibrationValues, curves)) {
+            for (CurvePoints& c : calibration.curves) ResponseCurve::setLinear(c);
+            len = offsetof(AllCalibrationValues, filterHz);
+        }
+        if (len == offsetof(AllCalibrationValues, filterHz)) {
+            calibration.filterHz = legacyFilterHz(calibration.filterAlpha);
+            len = offsetof(AllCalibrationValues, pedalFilters);
+        }
+        if (len == offsetof(AllCalibrationValues, pedalFilters)) {
+            for (PedalFilterConfig& f : calibration.pedalFilters) setDefaultFilter(f);
+            len = offsetof(AllCalibrationValues, pedalStages);
+        }
+        if (len == offsetof(AllCalibrationValues, pedalStages)) {
+            for (PedalStageConfig& st : calibration.pedalStages) st = {calibration.filterHz, 0, 0};
+            len = sizeof(AllCalibrationValues);
+        }
         if (len != sizeof(AllCalibrationValues) || calibration.magic != CALIBRATION_MAGIC) {
             resetToDefaults();
             return false;
         }
-        brake_scaling_factor = ADC_brake / calibration.brakeMaxForce;
+        if (calibration.filterHz > FILTER_MAX_HZ) calibration.filterHz = FILTER_MAX_HZ;
+        for (PedalFilterConfig& f : calibration.pedalFilters) {
+            if (f.mode > FILTER_MODE_ONE_EURO) setDefaultFilter(f);
+        }
+        for (PedalStageConfig& st : calibration.pedalStages) {
+            if (st.cutoffHz > FILTER_MAX_HZ) st.cutoffHz = FILTER_MAX_HZ;
+        }
+        for (CurvePoints& c : calibration.curves) {
+            if (!ResponseCurve::isValid(c)) ResponseCurve::setLinear(c);
+        }
+        updateBrakeScale();
         applyCalibration();
         return true;
     }
 
+    static void setDefaultFilter(PedalFilterConfig& f) {
+        f.mode = FILTER_MODE_EMA;
+        f.minCutoff = DEFAULT_EURO_MIN_CUTOFF;
+        f.beta = DEFAULT_EURO_BETA;
+    }
+
+    // Convierte el suavizado antiguo (% por iteración de loop()) a una frecuencia de
+    // corte equivalente, suponiendo FILTER_LEGACY_RATE_HZ: k = 1 - alpha por muestra.
+    static uint16_t legacyFilterHz(uint8_t alphaPct) {
+        if (alphaPct == 0) return 0;
+        if (alphaPct > 95) alphaPct = 95;
+        const float hz = -logf(alphaPct / 100.0f) * FILTER_LEGACY_RATE_HZ / (2.0f * PI);
+        if (hz < 1.0f) return 1;
+        if (hz > FILTER_MAX_HZ) return FILTER_MAX_HZ;
+        return (uint16_t)(hz + 0.5f);
+    }
+
+    // Recalcular todo lo que depende de brakeMaxForce
+    void updateBrakeScale() {
+        brakeScale.configure(calibration.brakeMaxForce, ADC_brake);
+        fb_brake_glitch.setMaxRate((int32_t)min(calibration.brakeMaxForce * BRAKE_MAX_SLEW_PER_S, 2.0e9f)); // Cabe en int32
+        int32_t idleBand = (int32_t)(calibration.brakeMaxForce * BRAKE_IDLE_BAND_PCT / 100);
+        fb_brake_zero.setIdleBand(idleBand, idleBand / 4);
+    }
+
+    // Lleva min/max de gas y embrague a la resolución actual del ADC si se
+    // guardaron con otro sobremuestreo (o sin él)
+    void matchCalibrationResolution() {
+        const uint8_t bits = pedals.getResolution(SimRacing::Gas);
+        if (calibration.adcBits == bits) return;
+
+        const int shift = (int)bits - (int)calibration.adcBits;
+        CalibrationValues* axes[] = { &calibration.gas, &calibration.clutch };
+        for (CalibrationValues* cal : axes) {
+            if (shift > 0) {
+                cal->min = cal->min << shift;
+                cal->max = ((cal->max + 1) << shift) - 1; // El fondo de escala sigue siendo fondo de escala
+            } else {
+                cal->min = cal->min >> -shift;
+                cal->max = cal->max >> -shift;
+            }
+        }
+        calibration.adcBits = bits;
+    }
+
     void applyCalibration() {
+        matchCalibrationResolution();
         pedals.setCalibration(
             {calibration.gas.min, calibration.gas.max},
             {calibration.brake.min, calibration.brake.max},
             {calibration.clutch.min, calibration.clutch.max}
         );
+        compileCurves();
+        applyFilter();
+    }
+
+    // Fijar la configuración guardada en las cadenas de filtros de los tres pedales
+    void applyFilter() {
+        configureChain(gasChain, SimRacing::Gas, ADC_Max);
+        configureChain(brakeChain, SimRacing::Brake, ADC_brake);
+        configureChain(clutchChain, SimRacing::Clutch, ADC_Max);
+    }
+
+    // Parámetros de cada etapa; las que la cadena no contiene se ignoran
+    template<typename Chain>
+    void configureChain(Chain& chain, SimRacing::Pedal id, int32_t fullScale) {
+        const PedalFilterConfig& f = calibration.pedalFilters[id];
+        const PedalStageConfig& st = calibration.pedalStages[id];
+        const bool euro = f.mode == FILTER_MODE_ONE_EURO;
+        chain.template with<EmaFilter>([&](EmaFilter& e) { e.setCutoffHz(euro ? 0 : st.cutoffHz); });
+        chain.template with<OneEuroFilter>([&](OneEuroFilter& e) {
+            e.configure(f.minCutoff, f.beta, fullScale);
+            e.setEnabled(euro);
+        });
+        chain.template with<Deadband>([&](Deadband& d) { d.configure(st.deadLow, st.deadHigh, fullScale); });
+    }
+
+    // Compilar las curvas de respuesta al fondo de escala de cada eje
+    void compileCurves() {
+        curves[SimRacing::Gas].compile(calibration.curves[SimRacing::Gas], ADC_Max);
+        curves[SimRacing::Brake].compile(calibration.curves[SimRacing::Brake], ADC_brake);
+        curves[SimRacing::Clutch].compile(calibration.curves[SimRacing::Clutch], ADC_Max);
     }
 
     // Variables Bluetooth 
     BLEServer *pServer = NULL;
     BLECharacteristic *pTxCharacteristic;
     bool deviceConnected = false;
+
+    // Comandos recibidos por BLE. onWrite corre en la tarea de la pila BLE, así que
+    // solo los copia a esta cola SPSC; se aplican desde loop() (processBleCommands),
+    // el mismo hilo que usa curvas y cadenas, y nunca se cambian a mitad de un frame.
+    static constexpr size_t BLE_COMMAND_LEN = 256;  // Incluye el terminador
+    static constexpr size_t BLE_COMMAND_QUEUE = 4;
+    struct BleCommand { char text[BLE_COMMAND_LEN]; };
+    SampleRing<BleCommand, BLE_COMMAND_QUEUE> bleCommands;
     
     // Buffer para Serial print y JSON
-    char printBuffer[256]; // Aumentado para seguridad
+    char printBuffer[320]; // Aumentado para seguridad (diagnóstico JSON con contadores de todos los pedales)
     
     void sendData(const char* data) {
         // Enviar por USB Serial
@@ -236,46 +510,96 @@ private:
         }
     }
 
-    // Variables de estado para filtrado EMA (float para precisión)
-    float gasFiltered = 0.0f;
-    float brakeFiltered = 0.0f;
-    float clutchFiltered = 0.0f;
-
-    // Función Helper para EMA
-    // alpha_pct: 0-100. (0% = Sin filtro/Instantaneo, 100% = Estático)
-    float filterEMA(float current, float previous, uint8_t alpha_pct) {
-        if (alpha_pct >= 100) return previous; // Evitar bloqueo total
-        if (alpha_pct == 0) return current;    // Paso directo
-        
-        // Invertimos la lógica para que el slider de UI sea intuitivo:
-        // UI 0% -> alpha 1.0 (Sin filtro)
-        // UI 90% -> alpha 0.1 (Mucho filtro)
-        float k = (100.0f - alpha_pct) / 100.0f;
-        return (current * k) + (previous * (1.0f - k));
-    }
-    
 public:
     void sendJsonState() {
-        // Formato: {"g":val, "b":val, "c":val, "rg":raw, "rb":raw, "rc":raw}
+        // Formato: {"g":val, "b":val, "c":val, "rg":raw, "rb":raw, "rc":raw, "bo":offset, "bd":deriva/min, "n":frame,
+        //          "ng"/"nb"/"nc": ruido estimado de cada pedal (cuentas de salida)}
+        // Todo sale del mismo frame que se envió por HID
+        const PedalAxis& g = frame.axis[SimRacing::Gas];
+        const PedalAxis& b = frame.axis[SimRacing::Brake];
+        const PedalAxis& c = frame.axis[SimRacing::Clutch];
         snprintf(printBuffer, sizeof(printBuffer), 
-                "{\"g\":%d,\"b\":%d,\"c\":%d,\"rg\":%d,\"rb\":%ld,\"rc\":%d}\n", 
-                gas.value, brake.value, clutch.value,
-                analogRead(Pin_Gas), fb_brake_raw, analogRead(Pin_Clutch));
+                "{\"g\":%d,\"b\":%d,\"c\":%d,\"rg\":%ld,\"rb\":%ld,\"rc\":%ld,\"bo\":%ld,\"bd\":%ld,\"n\":%lu,"
+                "\"ng\":%ld,\"nb\":%ld,\"nc\":%ld}\n", 
+                g.value, b.value, c.value,
+                (long)g.raw, (long)b.raw, (long)c.raw,
+                (long)fb_brake_zero.offset(), (long)fb_brake_zero.driftPerMinute(),
+                (unsigned long)frame.seq,
+                (long)gates[SimRacing::Gas].noise(), (long)gates[SimRacing::Brake].noise(),
+                (long)gates[SimRacing::Clutch].noise());
+        sendData(printBuffer);
+    }
+
+    void sendJsonDiagnostics() {
+        // Contadores de la etapa de rechazo y estadísticas de adquisición del freno
+        const GlitchRejector::Counters& rej = fb_brake_glitch.counters();
+        const uint32_t rate = fb_brake_stats.effectiveRateCentiHz();
+        snprintf(printBuffer, sizeof(printBuffer),
+                "{\"diag\":{\"bok\":%lu,\"bsat\":%lu,\"bslew\":%lu,\"bdrop\":%lu,"
+                "\"sps\":%u,\"rate\":%lu.%02lu,\"imin\":%lu,\"imax\":%lu,\"i99\":%lu,\"miss\":%lu,\"rdus\":%lu,"
+                "\"sg\":%lu,\"sc\":%lu}}\n",
+                (unsigned long)rej.accepted, (unsigned long)rej.saturated,
+                (unsigned long)rej.slew, (unsigned long)fb_brake_ring.dropped(),
+                fb_brake_stats.detectedRate(), (unsigned long)(rate / 100), (unsigned long)(rate % 100),
+                (unsigned long)fb_brake_stats.intervalMinUs(), (unsigned long)fb_brake_stats.intervalMaxUs(),
+                (unsigned long)fb_brake_stats.percentileUs(99), (unsigned long)fb_brake_stats.missed(),
+                (unsigned long)(fb_brake_stats.readCyclesPeak() / getCpuFrequencyMhz()),
+                (unsigned long)pedals.getSpikeCount(SimRacing::Gas), (unsigned long)pedals.getSpikeCount(SimRacing::Clutch));
+        sendData(printBuffer);
+    }
+
+    // Clave de un pedal en el JSON ('g', 'b', 'c') -> SimRacing::Pedal, -1 si no existe
+    static int pedalFromKey(char key) {
+        switch (key) {
+            case 'g': return SimRacing::Gas;
+            case 'b': return SimRacing::Brake;
+            case 'c': return SimRacing::Clutch;
+        }
+        return -1;
+    }
+
+    void sendJsonCurve(SimRacing::Pedal id) {
+        static const char keys[] = { 'g', 'b', 'c' };
+        const CurvePoints& c = calibration.curves[id];
+        int n = snprintf(printBuffer, sizeof(printBuffer), "{\"curve\":{\"p\":\"%c\",\"x\":[", keys[id]);
+        for (uint8_t i = 0; i < c.count; i++) n += snprintf(printBuffer + n, sizeof(printBuffer) - n, i ? ",%u" : "%u", c.x[i]);
+        n += snprintf(printBuffer + n, sizeof(printBuffer) - n, "],\"y\":[");
+        for (uint8_t i = 0; i < c.count; i++) n += snprintf(printBuffer + n, sizeof(printBuffer) - n, i ? ",%u" : "%u", c.y[i]);
+        snprintf(printBuffer + n, sizeof(printBuffer) - n, "]}}\n");
+        sendData(printBuffer);
+    }
+
+    void sendJsonFilter(SimRacing::Pedal id) {
+        static const char keys[] = { 'g', 'b', 'c' };
+        const PedalFilterConfig& f = calibration.pedalFilters[id];
+        const PedalStageConfig& st = calibration.pedalStages[id];
+        snprintf(printBuffer, sizeof(printBuffer),
+                "{\"filter\":{\"p\":\"%c\",\"mode\":\"%s\",\"min\":%u.%u,\"beta\":%u.%03u,\"hz\":%u,\"dl\":%u,\"dh\":%u}}\n",
+                keys[id], f.mode == FILTER_MODE_ONE_EURO ? "euro" : "ema",
+                f.minCutoff / 10, f.minCutoff % 10, f.beta / 1000, f.beta % 1000,
+                st.cutoffHz, st.deadLow, st.deadHigh);
         sendData(printBuffer);
     }
 
     void sendJsonCalibration() {
         // Formato para sincronizar la web: 
         snprintf(printBuffer, sizeof(printBuffer),
-                "{\"cal\":{\"gmin\":%d,\"gmax\":%d,\"bmax\":%.0f,\"cmin\":%d,\"cmax\":%d,\"filter\":%d}}\n",
+                "{\"cal\":{\"gmin\":%d,\"gmax\":%d,\"bmax\":%.0f,\"cmin\":%d,\"cmax\":%d,\"filter\":%d,\"res\":%d}}\n",
                 calibration.gas.min, calibration.gas.max, 
                 calibration.brakeMaxForce, 
                 calibration.clutch.min, calibration.clutch.max,
-                calibration.filterAlpha); // Enviar filtro actual
+                calibration.filterHz, // Enviar filtro actual (Hz)
+                pedals.getResolution(SimRacing::Gas)); // Bits de gas/embrague para escalar la web
         sendData(printBuffer);
+        sendJsonCurve(SimRacing::Gas);
+        sendJsonCurve(SimRacing::Brake);
+        sendJsonCurve(SimRacing::Clutch);
+        sendJsonFilter(SimRacing::Gas);
+        sendJsonFilter(SimRacing::Brake);
+        sendJsonFilter(SimRacing::Clutch);
     }
 
-    PedalManager(SimRacing::ThreePedals& p, HX711& b, JoystickWrapper& j) 
+    PedalManager(PedalSet& p, LoadCellADC& b, JoystickWrapper& j) 
         : pedals(p), brake_pedal(b), joystick(j) {}
 
     // Callbacks para eventos BLE
@@ -296,36 +620,88 @@ public:
         MyCallbacks(PedalManager* m) : _manager(m) {}
         void onWrite(BLECharacteristic *pCharacteristic) {
             String rxValue = pCharacteristic->getValue();
-            if (rxValue.length() > 0) {
-                if (rxValue[0] == '{') {
-                    _manager->handleJsonCommand(rxValue.c_str());
-                } else {
-                    _manager->handleSimpleCommand(rxValue); // Pass String for 'f' command
-                }
-            }
+            if (rxValue.length() == 0) return;
+            if (rxValue.length() >= BLE_COMMAND_LEN) return; // Truncado sería otro comando: se descarta
+            BleCommand cmd;
+            memcpy(cmd.text, rxValue.c_str(), rxValue.length() + 1);
+            _manager->bleCommands.push(cmd); // Llena: se descarta y se cuenta en dropped()
         }
     };
 
     void runHardwareDiagnostics() {
         Serial.println("\n--- DIAGNÓSTICO DE HARDWARE ---");
         
-        // 1. Verificar HX711 (Freno)
-        Serial.print("HX711 (Freno): ");
-        if (brake_pedal.is_ready()) {
+        // 1. Verificar célula de carga (Freno)
+        Serial.print("Célula de carga (Freno): ");
+        if (brake_pedal.is_ready() || brake_pedal.window_count() > 0) {
             Serial.println("OK (Listo)");
-            Serial.print("  > Valor Raw actual: ");
-            Serial.println(brake_pedal.read());
+            Serial.print("  > Valor Raw actual (media de ventana): ");
+            Serial.println(brake_pedal.read_window_average());
         } else {
             Serial.println("ERROR (No responde)");
-            Serial.println("  > Verifica pines: DOUT=" + String(LOADCELL_DOUT_PIN) + ", SCK=" + String(LOADCELL_SCK_PIN));
-            Serial.println("  > Asegúrate de que el HX711 tenga alimentación (VCC/GND)");
+            Serial.println("  > Verifica pines: DOUT/SDA=" + String(LOADCELL_DOUT_PIN) + ", SCK/SCL=" + String(LOADCELL_SCK_PIN));
+            Serial.println("  > Asegúrate de que el ADC tenga alimentación (VCC/GND)");
         }
+        Serial.print("  > Adquisición: ");
+        Serial.print(fb_brake_drdy_pin >= 0 ? "Interrupción dato listo" : "Polling");
+#if defined(BRAKE_NAU7802)
+        Serial.println(" / NAU7802 I2C");
+#elif defined(BRAKE_HX711_SPI)
+        Serial.println(" / SPI hardware");
+#elif defined(BRAKE_HX711_FAST)
+        Serial.println(" / Registros GPIO");
+#else
+        Serial.println(" / GPIO bit-bang");
+#endif
+        Serial.printf("  > Ciclos de CPU por lectura: %lu\n", (unsigned long)brake_pedal.get_read_cycles());
+        Serial.printf("  > Retardo dato listo -> lectura: %lu us (max %lu us)\n",
+                      (unsigned long)fb_brake_latency_us, (unsigned long)fb_brake_latency_max_us);
+        fb_brake_latency_max_us = 0;
+        Serial.printf("  > Muestras: seq %lu, descartadas por cola llena: %lu, lecturas fallidas: %lu\n",
+                      (unsigned long)frame.brakeSeq, (unsigned long)fb_brake_ring.dropped(),
+                      (unsigned long)fb_brake_read_errors);
+        Serial.printf("  > Tara: %s, offset %ld, deriva %ld cuentas/min\n",
+                      fb_brake_zero.ready() ? "OK" : "en curso",
+                      (long)fb_brake_zero.offset(), (long)fb_brake_zero.driftPerMinute());
+        const GlitchRejector::Counters& rej = fb_brake_glitch.counters();
+        Serial.printf("  > Rechazadas: saturación %lu, slew %lu (aceptadas %lu)\n",
+                      (unsigned long)rej.saturated, (unsigned long)rej.slew, (unsigned long)rej.accepted);
+
+        // Estadísticas de adquisición desde el último diagnóstico
+        const uint32_t rate = fb_brake_stats.effectiveRateCentiHz();
+        const uint32_t mhz = getCpuFrequencyMhz();
+        Serial.printf("  > Tasa: %lu.%02lu SPS efectiva, %u SPS detectada (declarada %u)\n",
+                      (unsigned long)(rate / 100), (unsigned long)(rate % 100),
+                      fb_brake_stats.detectedRate(), brake_pedal.sample_rate());
+        Serial.printf("  > Intervalo: min %lu us, max %lu us, p99 %lu us, conversiones perdidas %lu\n",
+                      (unsigned long)fb_brake_stats.intervalMinUs(), (unsigned long)fb_brake_stats.intervalMaxUs(),
+                      (unsigned long)fb_brake_stats.percentileUs(99), (unsigned long)fb_brake_stats.missed());
+        Serial.printf("  > Tiempo de lectura: media %lu us, max %lu us\n",
+                      (unsigned long)(fb_brake_stats.readCyclesAvg() / mhz),
+                      (unsigned long)(fb_brake_stats.readCyclesPeak() / mhz));
+        Serial.printf("  > Predicción: %s, velocidad %ld cuentas/s, intervalo medio %lu us\n",
+                      BRAKE_PREDICT ? "activa" : "desactivada",
+                      (long)brakePredictor.velocity(), (unsigned long)brakePredictor.interval());
+        fb_brake_stats.requestReset();
         
         // 2. Verificar Analógicos (Gas y Embrague)
         Serial.print("Gas (Pin " + String(Pin_Gas) + "): ");
-        Serial.println(analogRead(Pin_Gas));
+        pedals.update();
+        Serial.println(pedals.getPositionRaw(SimRacing::Gas));
         Serial.print("Embrague (Pin " + String(Pin_Clutch) + "): ");
-        Serial.println(analogRead(Pin_Clutch));
+        Serial.println(pedals.getPositionRaw(SimRacing::Clutch));
+        Serial.printf("  > ADC continuo: %s, %u bits, %s, %lu conversiones\n",
+                      SimRacing::ContinuousADC::handles(Pin_Gas) ? "DMA" : "analogRead",
+                      pedals.getResolution(SimRacing::Gas),
+                      SimRacing::ContinuousADC::linearized() ? "linealizado" : "sin linealizar",
+                      (unsigned long)SimRacing::ContinuousADC::conversions());
+        Serial.printf("  > Picos rechazados: gas %lu, embrague %lu\n",
+                      (unsigned long)pedals.getSpikeCount(SimRacing::Gas),
+                      (unsigned long)pedals.getSpikeCount(SimRacing::Clutch));
+        Serial.printf("  > Ruido / umbral de cambio: gas %ld/%ld, freno %ld/%ld, embrague %ld/%ld\n",
+                      (long)gates[SimRacing::Gas].noise(), (long)gates[SimRacing::Gas].threshold(),
+                      (long)gates[SimRacing::Brake].noise(), (long)gates[SimRacing::Brake].threshold(),
+                      (long)gates[SimRacing::Clutch].noise(), (long)gates[SimRacing::Clutch].threshold());
         
         Serial.println("-------------------------------\n");
     }
@@ -336,9 +712,26 @@ public:
         display.drawCenteredText(20, "PEDALERA ESP32-S3", GREEN, BLACK, 2);
         display.drawCenteredText(50, "Iniciando...", WHITE, BLACK, 1);
 
+        // Gas y embrague se muestrean en segundo plano por DMA; si falla, AnalogInput usa analogRead
+        static const int16_t analogPins[] = { Pin_Gas, Pin_Clutch };
+        SimRacing::ContinuousADC::setOversampling(ADC_OVERSAMPLING_LOG2);
+        if (!SimRacing::ContinuousADC::begin(analogPins, 2, ADC_SAMPLE_RATE)) {
+            Serial.println("[AVISO] ADC continuo no disponible, usando analogRead");
+        } else if (ADC_LINEARIZE && !SimRacing::ContinuousADC::setLinearization(true)) {
+            Serial.println("[AVISO] Sin calibración eFuse del ADC, lectura sin linealizar");
+        }
         pedals.begin();
-        brake_pedal.begin(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN);
-        brake_pedal.tare(10);
+        ADC_Max = (1 << pedals.getResolution(SimRacing::Gas)) - 1; // Salida HID y pantalla escalan con la resolución
+        // Mediana de 3 contra caídas del cursor de potenciómetros gastados (1 muestra de retardo)
+        pedals.setSpikeRejection(SimRacing::Gas, ADC_SPIKE_THRESHOLD);
+        pedals.setSpikeRejection(SimRacing::Clutch, ADC_SPIKE_THRESHOLD);
+        gates[SimRacing::Gas].begin(CHANGE_THRESHOLD_MIN, ADC_Max);
+        gates[SimRacing::Brake].begin(CHANGE_THRESHOLD_MIN, ADC_brake);
+        gates[SimRacing::Clutch].begin(CHANGE_THRESHOLD_MIN, ADC_Max);
+        brakePredictor.configure(BRAKE_PREDICT_ALPHA, BRAKE_PREDICT_BETA, BRAKE_PREDICT_OVERSHOOT, ADC_brake);
+        if (!brake_pedal.begin()) Serial.println("[ERROR] ADC de freno no responde");
+        brake_pedal.set_window(BRAKE_WINDOW_SIZE);
+        fb_brake_zero.begin(BRAKE_TARE_SAMPLES); // La tara se completa en la tarea, sin bloquear el arranque
         
         joystick.begin(true);
         loadCalibration();
@@ -382,9 +775,9 @@ public:
         if (millis() - lastUpdate < 50) return;
         lastUpdate = millis();
 
-        display.drawProgressBar(10, 30, 300, 20, gas.value, ADC_Max, GREEN, BLACK, DARKGRAY);
-        display.drawProgressBar(10, 70, 300, 20, brake.value, ADC_brake, RED, BLACK, DARKGRAY);
-        display.drawProgressBar(10, 110, 300, 20, clutch.value, ADC_Max, BLUE, BLACK, DARKGRAY);
+        display.drawProgressBar(10, 30, 300, 20, frame.axis[SimRacing::Gas].value, ADC_Max, GREEN, BLACK, DARKGRAY);
+        display.drawProgressBar(10, 70, 300, 20, frame.axis[SimRacing::Brake].value, ADC_brake, RED, BLACK, DARKGRAY);
+        display.drawProgressBar(10, 110, 300, 20, frame.axis[SimRacing::Clutch].value, ADC_Max, BLUE, BLACK, DARKGRAY);
         sendJsonState();
     }
 
@@ -393,9 +786,14 @@ public:
         calibration.brake = {DEFAULT_BRAKE_MIN, DEFAULT_BRAKE_MAX};
         calibration.clutch = {DEFAULT_CLUTCH_MIN, DEFAULT_CLUTCH_MAX};
         calibration.brakeMaxForce = DEFAULT_BRAKE_MAX_FORCE;
-        calibration.filterAlpha = DEFAULT_FILTER_ALPHA; // Initialize filter alpha
+        calibration.filterAlpha = 0;
+        calibration.filterHz = DEFAULT_FILTER_HZ;
+        for (PedalFilterConfig& f : calibration.pedalFilters) setDefaultFilter(f);
+        for (PedalStageConfig& st : calibration.pedalStages) st = {DEFAULT_FILTER_HZ, 0, 0};
+        calibration.adcBits = ADC_NATIVE_BITS; // Los valores por defecto están a 12 bits
+        for (CurvePoints& c : calibration.curves) ResponseCurve::setLinear(c);
         calibration.magic = CALIBRATION_MAGIC;
-        brake_scaling_factor = ADC_brake / calibration.brakeMaxForce;
+        updateBrakeScale();
         applyCalibration();
         saveCalibration();
     }
@@ -412,53 +810,104 @@ public:
         drawUI();
     }
 
-    inline bool checkChange(PedalState& state, int16_t newValue) {
-        if (abs(newValue - state.value) > CHANGE_THRESHOLD) {
-            state.value = newValue;
-            state.changed = true;
-            return true;
-        }
-        state.changed = false;
-        return false;
+    // Publica el nuevo valor solo si supera el umbral de ruido del pedal
+    inline bool checkChange(SimRacing::Pedal id, int32_t newValue) {
+        PedalAxis& state = frame.axis[id];
+        int32_t held = state.value;
+        state.changed = gates[id].update(newValue, held);
+        state.value = (int16_t)held;
+        return state.changed;
     }
 
-    void updateGas() {
-        int16_t rawValue = pedals.getPosition(SimRacing::Gas, 0, ADC_Max);
-        gasFiltered = filterEMA((float)rawValue, gasFiltered, calibration.filterAlpha);
-        
-        int16_t newValue = (int16_t)gasFiltered;
-        if (checkChange(gas, newValue)) joystick.setRyAxis(gas.value);
+    // Gas y embrague: misma secuencia, cada uno con su cadena de filtros
+    template<typename Chain>
+    void updateAnalog(SimRacing::Pedal id, Chain& chain) {
+        PedalAxis& axis = frame.axis[id];
+        axis.raw = pedals.getPositionRaw(id);
+        axis.calibrated = pedals.getPosition(id, 0, ADC_Max);
+        axis.filtered = chain.update(axis.calibrated, frame.timestamp);
+
+        checkChange(id, curves[id].apply(axis.filtered));
     }
 
     void updateBrake() {
-        // Lectura NO BLOQUEANTE desde variable compartida
-        long current_raw = fb_brake_raw; 
-        
-        // Aplicar Scaling Factor
-        float scaledValue = (float)constrain(current_raw * brake_scaling_factor, 0, ADC_brake);
+        // Lectura NO BLOQUEANTE: consumir solo muestras nuevas de la cola, drenando el atraso.
+        // El filtro se aplica una vez por muestra real, nunca sobre un valor ya filtrado.
+        PedalAxis& brake = frame.axis[SimRacing::Brake];
+        LoadCellSample sample;
+        bool fresh = false;
+        while (fb_brake_ring.pop(sample)) {
+            fresh = true;
+            brake.raw = sample.value;
+            frame.brakeSeq = sample.seq;
+            frame.brakeTimestamp = sample.micros;
 
-        // Aplicar Filtro EMA
-        brakeFiltered = filterEMA(scaledValue, brakeFiltered, calibration.filterAlpha);
+            // Aplicar Scaling Factor (entero)
+            brake.calibrated = brakeScale.apply(sample.value);
 
-        int16_t newValue = (int16_t)brakeFiltered;
-        if (checkChange(brake, newValue)) joystick.setRxAxis(brake.value);
-    }
+            // Aplicar el filtro con el dt real entre muestras del freno
+            brake.filtered = brakeChain.update(brake.calibrated, sample.micros);
+            if (BRAKE_PREDICT) brakePredictor.update(brake.filtered, sample.micros);
 
-    void updateClutch() {
-        float rawValue = (float)pedals.getPosition(SimRacing::Clutch, 0, ADC_Max);
-        clutchFiltered = filterEMA(rawValue, clutchFiltered, calibration.filterAlpha);
-        
-        int16_t newValue = (int16_t)clutchFiltered;
-        if (checkChange(clutch, newValue)) joystick.setZAxis(clutch.value);
+            // La histéresis solo ve muestras reales: su estimación de ruido no se
+            // contamina con los pasos pequeños de la extrapolación entre conversiones
+            gates[SimRacing::Brake].update(curves[SimRacing::Brake].apply(brake.filtered), brakeGated);
+        }
+
+        int32_t out = brakeGated;
+        if (BRAKE_PREDICT) {
+            // Publicar la estimación para este instante, haya o no muestra nueva: el eje
+            // avanza en rampa entre conversiones. Dentro de la banda de ruido alrededor
+            // del último valor aceptado se mantiene ese valor, así el freno quieto no
+            // genera informes HID.
+            const int32_t predicted = curves[SimRacing::Brake].apply(brakePredictor.estimate(micros()));
+            if (abs(predicted - brakeGated) > gates[SimRacing::Brake].threshold()) out = predicted;
+        } else if (!fresh) {
+            brake.changed = false; // El frame conserva la última muestra
+            return;
+        }
+        brake.changed = out != brake.value;
+        brake.value = (int16_t)out;
     }
 
-    void updateAll() {
+    // Una pasada de adquisición: lee cada pedal una sola vez y rellena el frame
+    void acquireFrame() {
         pedals.update();
-        updateGas();
+        frame.timestamp = micros();
+        frame.seq++;
+        updateAnalog(SimRacing::Gas, gasChain);
         updateBrake();
-        updateClutch();
-        updateScreen();
-        if (gas.changed || brake.changed || clutch.changed) joystick.sendState();
+        updateAnalog(SimRacing::Clutch, clutchChain);
+    }
+
+    // Envía por HID los ejes del frame que han cambiado
+    void sendFrame() {
+        const PedalAxis& g = frame.axis[SimRacing::Gas];
+        const PedalAxis& b = frame.axis[SimRacing::Brake];
+        const PedalAxis& c = frame.axis[SimRacing::Clutch];
+        if (!(g.changed || b.changed || c.changed)) return;
+        joystick.setRyAxis(g.value);
+        joystick.setRxAxis(b.value);
+        joystick.setZAxis(c.value);
+        joystick.sendState();
+    }
+
+    void updateAll() {
+        acquireFrame();
+        sendFrame();
+        updateScreen(); // Pantalla y telemetría del mismo frame
+    }
+
+    /** Aplica los comandos BLE pendientes; se llama desde loop(). */
+    void processBleCommands() {
+        BleCommand cmd;
+        while (bleCommands.pop(cmd)) {
+            if (cmd.text[0] == '{') {
+                handleJsonCommand(cmd.text);
+            } else {
+                handleSimpleCommand(String(cmd.text)); // Pass String for 'f' command
+            }
+        }
     }
 
     void handleSimpleCommand(const String& input) {
@@ -472,18 +921,25 @@ public:
             case 'r': resetToDefaults(); break;
             case 'm': sendJsonCalibration(); break;
             case 'd': runHardwareDiagnostics(); break;
+            case 'q': sendJsonDiagnostics(); break;
+            case 't': // Nueva tara del freno, asíncrona
+                fb_brake_zero.requestTare();
+                Serial.println("Tara del freno en curso...");
+                break;
             case 's': // Save
                 saveCalibration();
                 Serial.println("OK Saved");
                 break;
-            case 'f': // Filter config: f50 (50%)
+            case 'f': // Filter config: f20 (corte a 20 Hz), f0 (sin filtro)
                 {
                    String valStr = input.substring(1);
                    int val = valStr.toInt();
                    if (val < 0) val = 0;
-                   if (val > 95) val = 95; // Limitamos a 95% para evitar lag excesivo
-                   calibration.filterAlpha = (uint8_t)val;
-                   Serial.printf("Filter set to: %d%%\n", calibration.filterAlpha);
+                   if (val > FILTER_MAX_HZ) val = FILTER_MAX_HZ;
+                   calibration.filterHz = (uint16_t)val;
+                   for (PedalStageConfig& st : calibration.pedalStages) st.cutoffHz = (uint16_t)val;
+                   applyFilter();
+                   Serial.printf("Filter set to: %d Hz\n", calibration.filterHz);
                    // Opcional: Auto-save o esperar a 's'
                 }
                 break;
@@ -498,53 +954,205 @@ public:
     }
 
     void handleJsonCommand(const char* json) {
-        // No hay comandos JSON por ahora tras eliminar DZ
+        // Curva de respuesta: {"curve":{"p":"g","x":[0,50,100],"y":[0,25,100]}}
+        // Se aplica al momento; se guarda en flash con 's', igual que el filtro
+        if (jsonValue(json, "curve")) {
+            const char* pedal = jsonValue(json, "p");
+            int id = (pedal && *pedal == '"') ? pedalFromKey(pedal[1]) : -1;
+
+            CurvePoints points;
+            int nx = jsonIntArray(json, "x", points.x, CurvePoints::MAX_POINTS);
+            int ny = jsonIntArray(json, "y", points.y, CurvePoints::MAX_POINTS);
+            points.count = (uint8_t)nx;
+            if (id < 0 || nx != ny || !ResponseCurve::isValid(points)) {
+                Serial.println("[ERROR] Curva no válida");
+                return;
+            }
+            calibration.curves[id] = points;
+            compileCurves();
+            sendJsonCurve((SimRacing::Pedal)id);
+        }
+
+        // Filtro por pedal: {"filter":{"p":"b","mode":"euro","min":1.0,"beta":2.5,"hz":20,"dl":2,"dh":3}}
+        // mode "ema" usa el corte "hz" (lo fija 'f' para los tres); min (Hz), beta y las zonas
+        // muertas "dl"/"dh" (%) son opcionales
+        else if (jsonValue(json, "filter")) {
+            const char* pedal = jsonValue(json, "p");
+            int id = (pedal && *pedal == '"') ? pedalFromKey(pedal[1]) : -1;
+            if (id < 0) {
+                Serial.println("[ERROR] Filtro no válido");
+                return;
+            }
+            PedalFilterConfig f = calibration.pedalFilters[id];
+            PedalStageConfig st = calibration.pedalStages[id];
+            const char* mode = jsonValue(json, "mode");
+            if (mode) {
+                if (strncmp(mode, "\"euro\"", 6) == 0) f.mode = FILTER_MODE_ONE_EURO;
+                else if (strncmp(mode, "\"ema\"", 5) == 0) f.mode = FILTER_MODE_EMA;
+                else {
+                    Serial.println("[ERROR] Modo de filtro no válido");
+                    return;
+                }
+            }
+            const char* v = jsonValue(json, "min");
+            if (v) f.minCutoff = (uint16_t)constrain(lroundf(strtof(v, nullptr) * 10.0f), 1, FILTER_MAX_HZ * 10);
+            v = jsonValue(json, "beta");
+            if (v) f.beta = (uint16_t)constrain(lroundf(strtof(v, nullptr) * 1000.0f), 0, 65535);
+            v = jsonValue(json, "hz");
+            if (v) st.cutoffHz = (uint16_t)constrain(strtol(v, nullptr, 10), 0, FILTER_MAX_HZ);
+            v = jsonValue(json, "dl");
+            if (v) st.deadLow = (uint8_t)constrain(strtol(v, nullptr, 10), 0, Deadband::MAX_PERCENT);
+            v = jsonValue(json, "dh");
+            if (v) st.deadHigh = (uint8_t)constrain(strtol(v, nullptr, 10), 0, Deadband::MAX_PERCENT);
+
+            // La etapa inactiva (EMA o One Euro) sigue a la entrada: el cambio de modo no salta
+            calibration.pedalFilters[id] = f;
+            calibration.pedalStages[id] = st;
+            applyFilter();
+            sendJsonFilter((SimRacing::Pedal)id);
+        }
     }
     void startBrakeTask() {
-        if (TaskBrakeHandle == NULL) {
-            xTaskCreatePinnedToCore(
-                taskBrakeRead,    // Función de la tarea
-                "TaskBrake",      // Nombre
-                4096,             // Stack size
-                &brake_pedal,     // Parámetro (puntero al objeto hx711)
-                1,                // Prioridad
-                &TaskBrakeHandle, // Handle
-                0                 // Core 0 (El loop de Arduino corre en Core 1)
-            );
+        if (TaskBrakeHandle != NULL) {
+            // Tarea aparcada: levantar la petición y despertarla
+            fb_brake_stop_request = false;
+            xTaskNotifyGive(TaskBrakeHandle);
+            return;
         }
+        xTaskCreatePinnedToCore(
+            taskBrakeRead,    // Función de la tarea
+            "TaskBrake",      // Nombre
+            4096,             // Stack size
+            &brake_pedal,     // Parámetro (puntero al LoadCellADC)
+            1,                // Prioridad
+            &TaskBrakeHandle, // Handle
+            0                 // Core 0 (El loop de Arduino corre en Core 1)
+        );
     }
 
-    void stopBrakeTask() {
-        if (TaskBrakeHandle != NULL) {
-            vTaskDelete(TaskBrakeHandle);
-            TaskBrakeHandle = NULL;
+    // Pide a la tarea que se aparque al terminar la conversión en curso y espera la
+    // confirmación. Devuelve false si no confirma a tiempo (el bus podría seguir ocupado).
+    bool stopBrakeTask() {
+        if (TaskBrakeHandle == NULL) return true;
+        fb_brake_stop_request = true;
+        xTaskNotifyGive(TaskBrakeHandle); // Despertarla si espera el flanco de dato listo
+        const uint32_t start = millis();
+        while (!fb_brake_parked) {
+            if (millis() - start > BRAKE_STOP_TIMEOUT_MS) return false;
+            delay(1);
         }
+        return true;
     }
 };
 
-SimRacing::ThreePedals pedals(Pin_Gas, Pin_Brake, Pin_Clutch);
-HX711 brake_pedal;
+PedalSet pedals;
+#if defined(BRAKE_NAU7802)
+NAU7802WireBus brake_bus(Wire, LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN);
+NAU7802 brake_pedal(brake_bus, NAU7802::SPS_320, LOADCELL_DRDY_PIN);
+#elif defined(BRAKE_HX711_FAST)
+HX711Fast<LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN> brake_pedal;
+#else
+HX711 brake_pedal(LOADCELL_DOUT_PIN, LOADCELL_SCK_PIN);
+#endif
+#ifdef BRAKE_HX711_SPI
+HX711SpiBackend brake_spi_backend;
+#endif
 JoystickWrapper Joystick;
 PedalManager pedalManager(pedals, brake_pedal, Joystick);
 
-// Tarea FreeRTOS para lectura asíncrona de HX711
+// ISR del flanco de dato listo (DOUT del HX711 baja / DRDY del NAU7802 sube)
+void IRAM_ATTR isrBrakeReady() {
+    fb_brake_ready_us = micros();
+    BaseType_t woken = pdFALSE;
+    if (TaskBrakeHandle != NULL) vTaskNotifyGiveFromISR(TaskBrakeHandle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Tarea FreeRTOS para lectura asíncrona de la célula de carga
 void taskBrakeRead(void * parameter) {
-    HX711* sensor = (HX711*)parameter;
+    LoadCellADC* sensor = (LoadCellADC*)parameter;
+    static uint32_t seq = 0; // Continúa entre reinicios de la tarea
+
+    // La ISR se registra desde la propia tarea para que corra en el Core 0
+    // Sin pin de dato listo se recurre al polling
+    fb_brake_drdy_pin = BRAKE_USE_DRDY_IRQ ? sensor->ready_pin() : -1;
+    const bool useIrq = fb_brake_drdy_pin >= 0;
+    if (useIrq) {
+        attachInterrupt(digitalPinToInterrupt(fb_brake_drdy_pin), isrBrakeReady, sensor->ready_edge());
+    }
     
     // Bucle infinito de la tarea
     for(;;) {
-        // Si el sensor está listo, leemos.
-        // HX711 es lento (10Hz o 80Hz), así que esto blockeará "naturalmente" 
-        // esperando el pin DOUT, pero en este Core 0, sin afectar al Core 1.
+        // Parada pedida desde el loop: aquí no hay ninguna lectura a medias
+        if (fb_brake_stop_request) {
+            if (useIrq) detachInterrupt(digitalPinToInterrupt(fb_brake_drdy_pin));
+            fb_brake_parked = true;
+            // Se espera a que se levante la petición (y no con vTaskSuspend) para que un
+            // startBrakeTask() que llegue antes de dormirse no se pierda
+            while (fb_brake_stop_request) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            fb_brake_parked = false;
+            if (useIrq) {
+                ulTaskNotifyTake(pdTRUE, 0);
+                attachInterrupt(digitalPinToInterrupt(fb_brake_drdy_pin), isrBrakeReady, sensor->ready_edge());
+            }
+            continue;
+        }
+
+        // En modo interrupción la tarea duerme hasta que la ISR la notifica.
+        // El timeout cubre el caso de un flanco perdido (p.ej. DOUT ya bajo al rearmar la IRQ).
+        bool notified = false;
+        if (useIrq) {
+            notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BRAKE_IRQ_TIMEOUT_MS)) > 0;
+        }
+
         if (sensor->is_ready()) {
-            // Usamos get_value() para obtener el valor con TARA ya aplicada.
-            // Esto resta el offset automáticamente.
-            long raw = sensor->get_value();
-            
-            // Actualización atómica (simple asignación de 32-bit es atómica en ESP32)
-            fb_brake_raw = raw;
-            fb_brake_ready = true;
-        } else {
+            // Los bits de datos también generan flancos en DOUT: desactivamos la IRQ durante la lectura
+            if (useIrq) gpio_intr_disable((gpio_num_t)fb_brake_drdy_pin);
+
+            uint32_t readyAt = micros();
+            if (notified) {
+                uint32_t latency = readyAt - fb_brake_ready_us;
+                readyAt = fb_brake_ready_us;
+                fb_brake_latency_us = latency;
+                if (latency > fb_brake_latency_max_us) fb_brake_latency_max_us = latency;
+            }
+
+            // Leemos el código crudo para detectar saturación y restamos la TARA con
+            // aritmética entera (get_value() pasa por double, emulado por software).
+            long code = sensor->read();
+            if (code == LoadCellADC::READ_FAILED) {
+                // Fallo de bus o timeout: la muestra se descarta sin tocar tara, estadísticas ni filtros
+                fb_brake_read_errors++;
+            } else {
+                ++seq;
+                fb_brake_stats.record(readyAt, sensor->get_read_cycles());
+
+                // Tara asíncrona / seguimiento de deriva con conversiones válidas
+                bool wasZeroed = fb_brake_zero.ready();
+                if (!GlitchRejector::isInvalidCode((int32_t)code) &&
+                    fb_brake_zero.update((int32_t)code, readyAt)) {
+                    sensor->set_offset(fb_brake_zero.offset());
+                }
+
+                // Hasta tener tara no se publica nada: el freno se queda en 0
+                if (fb_brake_zero.ready()) {
+                    if (!wasZeroed) fb_brake_glitch.reset(); // El historial previo no tenía tara
+                    long raw = code - fb_brake_zero.offset();
+
+                    // Rechazo de glitches: saturación, mediana de 3 y slew máximo
+                    int32_t clean;
+                    if (fb_brake_glitch.process((int32_t)code, (int32_t)raw, readyAt, clean)) {
+                        // Publicar en la cola lock-free hacia el loop (Core 1)
+                        fb_brake_ring.push({clean, seq, readyAt});
+                    }
+                }
+            }
+
+            if (useIrq) {
+                ulTaskNotifyTake(pdTRUE, 0); // Descartar notificaciones provocadas por la propia lectura
+                gpio_intr_enable((gpio_num_t)fb_brake_drdy_pin);
+            }
+        } else if (!useIrq) {
             // Breve espera para no saturar si algo falla con is_ready
             vTaskDelay(1 / portTICK_PERIOD_MS);
         }
@@ -553,6 +1161,9 @@ void taskBrakeRead(void * parameter) {
 
 void setup() {
     Serial.begin(115200);
+#ifdef BRAKE_HX711_SPI
+    brake_pedal.set_backend(&brake_spi_backend);
+#endif
     pedalManager.init();
 }
 
@@ -568,5 +1179,6 @@ void loop() {
             }
         }
     }
+    pedalManager.processBleCommands();
     pedalManager.updateAll();
 }
\ No newline at end of file
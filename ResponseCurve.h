@@ -0,0 +1,106 @@
+/**
+ * @file ResponseCurve.h
+ * @brief Curvas de respuesta por pedal (tramos lineales) compiladas a una tabla entera.
+ *
+ * La curva se define con hasta MAX_POINTS puntos (x, y) en % de recorrido y se
+ * guarda tal cual en el blob de Preferences. Al cambiarla se compila una sola vez
+ * en una tabla de 2^LUT_BITS + 1 entradas en unidades de salida; por muestra solo
+ * queda una multiplicación para el índice y una interpolación entre dos entradas,
+ * O(1) y sin coma flotante. Con la curva lineal por defecto se salta la tabla.
+ */
+#pragma once
+#include <Arduino.h>
+
+// Definición persistente: puntos en % (0..100) con x estrictamente creciente.
+// Antes del primer punto y después del último la salida se mantiene constante.
+struct CurvePoints {
+    static constexpr uint8_t MAX_POINTS = 8;
+    uint8_t count;
+    uint8_t x[MAX_POINTS];
+    uint8_t y[MAX_POINTS];
+} __attribute__((packed));
+
+class ResponseCurve {
+public:
+    static constexpr uint8_t LUT_BITS = 8;
+    static constexpr uint16_t LUT_SIZE = (1 << LUT_BITS) + 1; // +1: la última entrada es el fondo de escala
+
+    /** Rellena una definición con la recta identidad (0,0)-(100,100). */
+    static void setLinear(CurvePoints& p) {
+        p.count = 2;
+        p.x[0] = 0;   p.y[0] = 0;
+        p.x[1] = 100; p.y[1] = 100;
+    }
+
+    /** Comprueba que una definición recibida o leída de flash es utilizable. */
+    static bool isValid(const CurvePoints& p) {
+        if (p.count < 2 || p.count > CurvePoints::MAX_POINTS) return false;
+        for (uint8_t i = 0; i < p.count; i++) {
+            if (p.x[i] > 100 || p.y[i] > 100) return false;
+            if (i > 0 && p.x[i] <= p.x[i - 1]) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compila la curva para entradas y salidas en 0..fullScale.
+     * Una definición inválida se compila como lineal y devuelve false.
+     */
+    bool compile(const CurvePoints& p, int32_t fullScale) {
+        scale = fullScale > 0 ? fullScale : 1;
+        step = ((uint32_t)(LUT_SIZE - 1) << 16) / (uint32_t)scale;
+
+        if (!isValid(p)) {
+            linear = true;
+            return false;
+        }
+        linear = p.count == 2 && p.x[0] == 0 && p.y[0] == 0 && p.x[1] == 100 && p.y[1] == 100;
+        if (linear) return true;
+
+        // Entrada i de la tabla en x = i * 100 / 2^LUT_BITS %. Trabajamos en
+        // unidades de 1/2^LUT_BITS % para que todo sea entero y exacto.
+        uint8_t seg = 0;
+        for (uint16_t i = 0; i < LUT_SIZE; i++) {
+            const int32_t xq = (int32_t)i * 100;
+            while (seg + 1 < p.count && ((int32_t)p.x[seg + 1] << LUT_BITS) < xq) seg++;
+
+            int64_t num, den; // y en % = num / den
+            if (xq <= ((int32_t)p.x[0] << LUT_BITS)) {
+                num = p.y[0]; den = 1;
+            } else if (seg + 1 >= p.count) {
+                num = p.y[p.count - 1]; den = 1;
+            } else {
+                const int32_t x0 = (int32_t)p.x[seg] << LUT_BITS;
+                const int32_t dx = ((int32_t)p.x[seg + 1] - p.x[seg]) << LUT_BITS;
+                const int32_t dy = (int32_t)p.y[seg + 1] - p.y[seg];
+                num = (int64_t)p.y[seg] * dx + (int64_t)dy * (xq - x0);
+                den = dx;
+            }
+            den *= 100;
+            table[i] = (int32_t)((num * scale + den / 2) / den); // Redondeo al más cercano
+        }
+        return true;
+    }
+
+    /** Aplica la curva a un valor en 0..fullScale. */
+    inline int32_t apply(int32_t v) const {
+        if (linear) return v;
+        if (v <= 0) return table[0];
+        if (v >= scale) return table[LUT_SIZE - 1];
+
+        // Índice en Q16: parte entera = entrada de la tabla, fracción = interpolación
+        const uint32_t pos = (uint32_t)v * step;
+        const uint32_t idx = pos >> 16;
+        if (idx >= LUT_SIZE - 1) return table[LUT_SIZE - 1];
+        const int32_t frac = (int32_t)(pos & 0xFFFF);
+        return table[idx] + (((table[idx + 1] - table[idx]) * frac) >> 16);
+    }
+
+    bool isLinear() const { return linear; }
+
+private:
+    int32_t table[LUT_SIZE] = {};
+    int32_t scale = 1;
+    uint32_t step = 0;
+    bool linear = true;
+};
@@ -0,0 +1,73 @@
+/**
+ * @file SampleRing.h
+ * @brief Cola circular lock-free de un productor y un consumidor (SPSC) entre núcleos.
+ *
+ * Pensada para pasar muestras de la tarea de adquisición (Core 0) al loop (Core 1)
+ * sin mutex: el productor solo escribe `head` y el consumidor solo escribe `tail`.
+ * La publicación usa orden release/acquire, de modo que el consumidor nunca ve un
+ * índice antes que los datos del registro al que apunta.
+ */
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+
+/** Muestra de una célula de carga con número de secuencia y marca de tiempo (micros()). */
+struct LoadCellSample {
+    int32_t value;    ///< Valor con tara aplicada
+    uint32_t seq;     ///< Número de secuencia; un salto indica muestras perdidas
+    uint32_t micros;  ///< Instante en que la conversión estuvo lista
+};
+
+/**
+ * @brief Cola SPSC de capacidad fija.
+ * @tparam T tipo del registro (copiable)
+ * @tparam N capacidad, potencia de 2
+ */
+template<typename T, size_t N>
+class SampleRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SampleRing: N debe ser potencia de 2");
+
+public:
+    /**
+     * @brief Encola un registro (solo productor).
+     * Si la cola está llena la muestra nueva se descarta y se cuenta en dropped():
+     * el productor nunca toca `tail`, así que no puede expulsar la más antigua.
+     * @return false si la cola estaba llena
+     */
+    bool push(const T& item) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Extrae el registro más antiguo (solo consumidor).
+     * @return false si no hay muestras nuevas
+     */
+    bool pop(T& out) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        out = buffer[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Número de registros pendientes de consumir. */
+    size_t available() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    /** Muestras descartadas por cola llena desde el arranque. */
+    uint32_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    T buffer[N];
+    std::atomic<uint32_t> head{0};          ///< Escrito solo por el productor
+    std::atomic<uint32_t> tail{0};          ///< Escrito solo por el consumidor
+    std::atomic<uint32_t> droppedCount{0};
+};
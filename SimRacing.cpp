@@ -21,6 +21,7 @@
  */
 
 #include "SimRacing.h"
+#include "AnalogDMA.h"
 
 /**
 * @file SimRacing.cpp
@@ -362,6 +363,7 @@ AnalogInput::AnalogInput(PinNum pin)
 	if (pin != UnusedPin) {
 		pinMode(pin, INPUT);
 	}
+	this->scaler.valid = false;
 }
 
 bool AnalogInput::read() {
@@ -369,7 +371,12 @@ bool AnalogInput::read() {
 
 	if (pin != UnusedPin) {
 		const int previous = this->position;
-		this->position = analogRead(pin);
+
+		// pins scanned by the continuous ADC are never converted on demand,
+		// both to avoid blocking and to keep analogRead() off the DMA unit
+		int value;
+		if (ContinuousADC::fetch(pin, value)) this->position = value;
+		else if (!ContinuousADC::handles(pin)) this->position = spikes.filter(analogRead(pin));
 
 		// check if value is different for 'changed' flag
 		if (previous != this->position) {
@@ -398,14 +405,83 @@ bool AnalogInput::read() {
 }
 
 long AnalogInput::getPosition(long rMin, long rMax) const {
-	// inversion is handled within the remap function
-	return remap(getPositionRaw(), getMin(), getMax(), rMin, rMax);
+	if (!scaler.valid || scaler.outMin != rMin || scaler.outMax != rMax) {
+		updateScaler(rMin, rMax);
+	}
+	if (!scaler.exact) return remap(getPositionRaw(), getMin(), getMax(), rMin, rMax);
+
+	// remap() with the inversion and the end values folded into the scaler
+	const long value = getPositionRaw();
+	if (value <= scaler.lo) return scaler.atLo;
+	if (value >= scaler.hi) return scaler.atHi;
+
+	// map() truncates towards zero, so a descending range is the
+	// negated quotient of the ascending one
+	const uint32_t delta = (uint32_t)(scaler.inverted ? scaler.hi - value : value - scaler.lo);
+	const long step = (long)(((uint64_t)(delta << scaler.preShift) * scaler.factor) >> 32);
+	return scaler.negative ? rMin - step : rMin + step;
+}
+
+void AnalogInput::updateScaler(long rMin, long rMax) const {
+	scaler.outMin = rMin;
+	scaler.outMax = rMax;
+	scaler.valid = true;
+	scaler.exact = false;
+
+	scaler.inverted = getMin() > getMax();
+	scaler.lo = min(getMin(), getMax());
+	scaler.hi = max(getMin(), getMax());
+	scaler.atLo = scaler.inverted ? rMax : rMin;
+	scaler.atHi = scaler.inverted ? rMin : rMax;
+
+	const uint64_t span = (uint64_t)(scaler.hi - scaler.lo);
+	const bool negative = rMax < rMin;
+	const uint64_t rise = negative ? (uint64_t)rMin - (uint64_t)rMax : (uint64_t)rMax - (uint64_t)rMin;
+
+	// with numerators below span * rise, a reciprocal rounded up at
+	// 2^shift > span^2 has an error too small to change the truncated
+	// quotient. The product is taken as the high word of a 32 x 32 bit
+	// multiply, so the shift is made up to 32 by pre-shifting the input
+	// (delta < span < 2^shift keeps it within 32 bits).
+	if (span == 0 || span >= (1UL << 16) || rise >= (1ULL << 32)) return;
+
+	uint8_t shift = 0;
+	while ((1ULL << shift) <= span * span) ++shift;
+
+	const uint64_t factor = ((rise << shift) + span - 1) / span;
+	if (factor > UINT32_MAX) return;  // too steep for a 32-bit factor, map() it is
+
+	scaler.factor = (uint32_t)factor;
+	scaler.preShift = 32 - shift;
+	scaler.negative = negative;
+	scaler.exact = true;
 }
 
 int AnalogInput::getPositionRaw() const {
 	return this->position;
 }
 
+uint8_t AnalogInput::getResolution() const {
+	if (ContinuousADC::handles(pin)) return ContinuousADC::resolution();
+
+#if defined(ARDUINO_ARCH_ESP32)
+	return 12;  // analogRead() default on the ESP32 family
+#else
+	return 10;
+#endif
+}
+
+void AnalogInput::setSpikeRejection(int threshold) {
+	if (pin == UnusedPin) return;
+	if (ContinuousADC::handles(pin)) ContinuousADC::setSpikeRejection(pin, threshold);
+	else spikes.setThreshold(threshold);
+}
+
+uint32_t AnalogInput::getSpikeCount() const {
+	if (ContinuousADC::handles(pin)) return ContinuousADC::spikeCount(pin);
+	return spikes.getCount();
+}
+
 bool AnalogInput::isInverted() const {
 	return (this->cal.min > this->cal.max);  // inverted if min is greater than max
 }
@@ -424,6 +500,7 @@ void AnalogInput::setInverted(bool invert) {
 
 void AnalogInput::setCalibration(AnalogInput::Calibration newCal) {
 	this->cal = newCal;
+	updateScaler(AnalogInput::Min, AnalogInput::Max);  // the default range, others are built on first use
 }
 
 //#########################################################
@@ -514,6 +591,21 @@ int Pedals::getPositionRaw(PedalID pedal) const {
 	return pedalData[pedal].getPositionRaw();
 }
 
+uint8_t Pedals::getResolution(PedalID pedal) const {
+	if (!hasPedal(pedal)) return 0;  // not a pedal
+	return pedalData[pedal].getResolution();
+}
+
+void Pedals::setSpikeRejection(PedalID pedal, int threshold) {
+	if (!hasPedal(pedal)) return;
+	pedalData[pedal].setSpikeRejection(threshold);
+}
+
+uint32_t Pedals::getSpikeCount(PedalID pedal) const {
+	if (!hasPedal(pedal)) return 0;  // not a pedal
+	return pedalData[pedal].getSpikeCount();
+}
+
 bool Pedals::hasPedal(PedalID pedal) const {
 	return (pedal < getNumPedals());
 }
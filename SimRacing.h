@@ -132,6 +132,78 @@ namespace SimRacing {
 	};
 
 
+	/**
+	* @brief Median-of-3 filter that drops isolated spikes from a sample stream
+	*
+	* Worn potentiometers can lose wiper contact for a single sample, reading
+	* as a jump to either rail. A median of the last three samples removes
+	* any such one-sample excursion while passing real steps through with
+	* exactly one sample of delay.
+	*
+	* A spike is counted when a sample stuck out of both of its neighbours,
+	* in the same direction, by more than the threshold. The threshold only
+	* affects the count (and enabling), not what the median passes.
+	*/
+	class SpikeRejector {
+	public:
+		/**
+		* Sets the jump size that counts as a spike
+		*
+		* @param t the spike threshold, in raw ADC counts. 0 disables the filter.
+		*/
+		void setThreshold(int t) { threshold = t > 0 ? t : 0; filled = 0; }
+
+		/**
+		* Checks whether the filter is active
+		*
+		* @return 'true' if samples are being filtered
+		*/
+		bool enabled() const { return threshold > 0; }
+
+		/**
+		* Filters one sample
+		*
+		* @param x the newest sample
+		* @return the median of the last three samples
+		*/
+		int filter(int x) {
+			if (threshold == 0) return x;
+			if (filled < 2) {
+				a = b;
+				b = x;
+				++filled;
+				return x;
+			}
+
+			// 'b' is the sample that just got its second neighbour
+			if ((b - a > threshold && b - x > threshold) || (a - b > threshold && x - b > threshold)) {
+				++count;
+			}
+
+			const int lo = min(a, b);
+			const int hi = max(a, b);
+			const int median = x < lo ? lo : (x > hi ? hi : x);
+			a = b;
+			b = x;
+			return median;
+		}
+
+		/**
+		* Retrieves the number of spikes removed so far
+		*
+		* @return the spike count
+		*/
+		uint32_t getCount() const { return count; }
+
+	private:
+		int a = 0;              ///< sample before last
+		int b = 0;              ///< last sample
+		uint8_t filled = 0;     ///< number of valid history samples
+		int threshold = 0;      ///< spike threshold, 0 if disabled
+		uint32_t count = 0;     ///< number of spikes counted
+	};
+
+
 	/**
 	* @brief Handle I/O for analog (ADC) inputs
 	*/
@@ -175,6 +247,17 @@ namespace SimRacing {
 		*/
 		int getPositionRaw() const;
 
+		/**
+		* Retrieves the width of the raw values returned by getPositionRaw().
+		*
+		* This is the converter's native width unless the pin is sampled by
+		* the ContinuousADC backend, in which case it includes any bits
+		* gained through oversampling.
+		*
+		* @return the resolution of the raw position, in bits
+		*/
+		uint8_t getResolution() const;
+
 		/**
 		* Retrieves the calibrated minimum position.
 		*
@@ -189,6 +272,26 @@ namespace SimRacing {
 		*/
 		int getMax() const { return this->cal.max; }
 
+		/**
+		* Enables the spike rejection stage (median-of-3) for this input.
+		*
+		* For pins sampled by the ContinuousADC backend the filter runs on
+		* every conversion, ahead of decimation, so a one-conversion dropout
+		* never reaches the average. Otherwise it runs on each read().
+		* Either way a real step is delayed by one sample.
+		*
+		* @param threshold the jump, in raw ADC counts, that counts as a
+		*                  spike. 0 disables the stage.
+		*/
+		void setSpikeRejection(int threshold);
+
+		/**
+		* Retrieves the number of spikes rejected on this input.
+		*
+		* @return the spike count
+		*/
+		uint32_t getSpikeCount() const;
+
 		/**
 		* Check whether the axis is inverted or not.
 		*
@@ -239,9 +342,44 @@ namespace SimRacing {
 		void setCalibration(Calibration newCal);
 
 	private:
+		/**
+		* @brief Precomputed rescaling from the calibrated range to one
+		* output range
+		*
+		* The division in map() is replaced by the high word of a 32 x 32 bit
+		* multiply with a fixed-point reciprocal of the input span, rounded up
+		* so that the truncated result is bit-exact with map() over every
+		* input in range. The inversion and the clamped end values are folded
+		* in as well, leaving two compares and one multiply per read.
+		*/
+		struct Scaler {
+			long outMin;         ///< output range minimum the scaler was built for
+			long outMax;         ///< output range maximum the scaler was built for
+			long lo;             ///< lower end of the calibrated range
+			long hi;             ///< upper end of the calibrated range
+			long atLo;           ///< output at or below 'lo'
+			long atHi;           ///< output at or above 'hi'
+			uint32_t factor;     ///< ceil(|outMax - outMin| * 2^(32 - preShift) / span)
+			uint8_t preShift;    ///< left shift of the input so the product's high word is the result
+			bool inverted;       ///< whether the calibration is inverted (min > max)
+			bool negative;       ///< whether the output range is descending
+			bool exact;          ///< whether the fast path is exact for this range, otherwise it falls back to map()
+			bool valid;          ///< whether the scaler matches the current calibration
+		};
+
+		/**
+		* Builds the scaler for the current calibration and a given output range
+		*
+		* @param rMin the minimum output value for the rescaling function
+		* @param rMax the maximum output value for the rescaling function
+		*/
+		void updateScaler(long rMin, long rMax) const;
+
 		PinNum pin;              ///< the digital pin number for this input
 		int position;            ///< the axis' position in its range, buffered
 		Calibration cal;         ///< the calibration values for the axis
+		mutable Scaler scaler;   ///< cached rescaling for the last requested output range
+		SpikeRejector spikes;    ///< spike rejection for pins read with analogRead()
 	};
 
 
@@ -374,6 +512,34 @@ namespace SimRacing {
 		*/
 		int getPositionRaw(PedalID pedal) const;
 
+		/**
+		* Retrieves the resolution of the pedal's raw position.
+		*
+		* @param pedal the pedal to retrieve the resolution for
+		* @return the resolution of the raw position in bits, 0 if the pedal
+		*         is not present
+		*/
+		uint8_t getResolution(PedalID pedal) const;
+
+		/**
+		* Enables spike rejection for a pedal.
+		*
+		* @param pedal the pedal to configure
+		* @param threshold the jump, in raw ADC counts, that counts as a spike.
+		*                  0 disables the stage.
+		*
+		* @see AnalogInput::setSpikeRejection()
+		*/
+		void setSpikeRejection(PedalID pedal, int threshold);
+
+		/**
+		* Retrieves the number of spikes rejected on a pedal.
+		*
+		* @param pedal the pedal to retrieve the count for
+		* @return the spike count, 0 if the pedal is not present
+		*/
+		uint32_t getSpikeCount(PedalID pedal) const;
+
 		/**
 		* Checks if a given pedal is present in the class.
 		* 
@@ -490,6 +656,152 @@ namespace SimRacing {
 		AnalogInput pedalData[NumPedals];    ///< pedal data storage struct, passed to AxisManager
 	};
 
+	/**
+	* @brief Pedal set with the pins fixed at compile time
+	*
+	* The pins are template arguments, in SimRacing::Pedal order (gas, brake,
+	* clutch), so the number of pedals is a constant. Unlike ThreePedals this
+	* is not a Peripheral: there is no base class, no virtual call and no
+	* detector poll per update, and the pedal storage is a member array
+	* indexed directly. The per-update read of every input is expanded at
+	* compile time into straight-line calls to AnalogInput::read(), and the
+	* accessors bound-check against a constant, which folds away for
+	* constant pedal IDs. Pedals that aren't wired to an analog pin can be
+	* given UnusedPin.
+	*
+	* It has the subset of the Pedals interface used to drive pedals
+	* (no device detection and no serial calibration tool):
+	* @code
+	* SimRacing::StaticPedals<A0, A1, A2> pedals;  // instead of ThreePedals(A0, A1, A2)
+	* @endcode
+	*
+	* @tparam Pins the analog pins for each pedal
+	*/
+	template<PinNum... Pins>
+	class StaticPedals {
+	public:
+		/** Scoped alias for SimRacing::Pedal */
+		using PedalID = SimRacing::Pedal;
+
+		static constexpr uint8_t NumPedals = sizeof...(Pins);  ///< number of pedals handled by this class
+		static_assert(NumPedals >= 1 && NumPedals <= 3, "StaticPedals handles one to three pedals");
+
+		/**
+		* Class constructor
+		*/
+		StaticPedals()
+			: pedalData{ AnalogInput(Pins)... }, changed(false)
+		{}
+
+		/**
+		* Initializes the pedals, reading their initial position
+		*/
+		void begin() { update(); }
+
+		/**
+		* Reads every pedal
+		*
+		* @return 'true' if any of the positions changed
+		*/
+		bool update() {
+			changed = readFrom(Index<0>());
+			return changed;
+		}
+
+		/** @copydoc Pedals::getPosition(PedalID, long, long) const */
+		long getPosition(PedalID pedal, long rMin = 0, long rMax = 100) const {
+			if (!hasPedal(pedal)) return rMin;  // not a pedal
+			return pedalData[pedal].getPosition(rMin, rMax);
+		}
+
+		/** @copydoc Pedals::getPositionRaw(PedalID) const */
+		int getPositionRaw(PedalID pedal) const {
+			if (!hasPedal(pedal)) return AnalogInput::Min;  // not a pedal
+			return pedalData[pedal].getPositionRaw();
+		}
+
+		/** @copydoc Pedals::getResolution(PedalID) const */
+		uint8_t getResolution(PedalID pedal) const {
+			if (!hasPedal(pedal)) return 0;  // not a pedal
+			return pedalData[pedal].getResolution();
+		}
+
+		/** @copydoc Pedals::setSpikeRejection(PedalID, int) */
+		void setSpikeRejection(PedalID pedal, int threshold) {
+			if (!hasPedal(pedal)) return;  // not a pedal
+			pedalData[pedal].setSpikeRejection(threshold);
+		}
+
+		/** @copydoc Pedals::getSpikeCount(PedalID) const */
+		uint32_t getSpikeCount(PedalID pedal) const {
+			if (!hasPedal(pedal)) return 0;  // not a pedal
+			return pedalData[pedal].getSpikeCount();
+		}
+
+		/** @copydoc Pedals::hasPedal(PedalID) const */
+		static constexpr bool hasPedal(PedalID pedal) { return pedal >= 0 && pedal < NumPedals; }
+
+		/** @copydoc Pedals::getNumPedals() const */
+		static constexpr int getNumPedals() { return NumPedals; }
+
+		/** @copydoc Pedals::positionChanged() const */
+		bool positionChanged() const { return changed; }
+
+		/** @copydoc Pedals::setCalibration(PedalID, AnalogInput::Calibration) */
+		void setCalibration(PedalID pedal, AnalogInput::Calibration cal) {
+			if (!hasPedal(pedal)) return;  // not a pedal
+			pedalData[pedal].setCalibration(cal);
+			pedalData[pedal].setPosition(pedalData[pedal].getMin());  // reset to min position, as Pedals does
+		}
+
+		/**
+		* Sets the calibration data (min/max) for the gas and brake pedals
+		*
+		* @param gasCal the calibration data for the gas pedal
+		* @param brakeCal the calibration data for the brake pedal
+		*/
+		void setCalibration(AnalogInput::Calibration gasCal, AnalogInput::Calibration brakeCal) {
+			static_assert(NumPedals >= 2, "StaticPedals has no brake pedal");
+			setCalibration(PedalID::Gas, gasCal);
+			setCalibration(PedalID::Brake, brakeCal);
+		}
+
+		/**
+		* Sets the calibration data (min/max) for the pedals
+		*
+		* @param gasCal the calibration data for the gas pedal
+		* @param brakeCal the calibration data for the brake pedal
+		* @param clutchCal the calibration data for the clutch pedal
+		*/
+		void setCalibration(AnalogInput::Calibration gasCal, AnalogInput::Calibration brakeCal, AnalogInput::Calibration clutchCal) {
+			static_assert(NumPedals >= 3, "StaticPedals has no clutch pedal");
+			setCalibration(PedalID::Gas, gasCal);
+			setCalibration(PedalID::Brake, brakeCal);
+			setCalibration(PedalID::Clutch, clutchCal);
+		}
+
+	private:
+		/** Compile-time pedal index, used to unroll the read */
+		template<uint8_t I> struct Index {};
+
+		/**
+		* Reads pedal I and every pedal after it
+		*
+		* @return 'true' if any of the positions changed
+		*/
+		template<uint8_t I>
+		bool readFrom(Index<I>) {
+			const bool current = pedalData[I].read();  // always read, no short-circuit
+			return readFrom(Index<I + 1>()) | current;
+		}
+
+		/** End of the unrolled read */
+		bool readFrom(Index<NumPedals>) { return false; }
+
+		AnalogInput pedalData[NumPedals];  ///< pedal data storage
+		bool changed;                      ///< whether the pedal position has changed since the previous update
+	};
+
 	/// @} Pedals
 
 
@@ -0,0 +1,52 @@
+/**
+ * @file Arduino.cpp
+ * @brief Implementación en el PC de las funciones declaradas en test/Arduino.h.
+ */
+#include <Arduino.h>
+#include "soc/soc.h"
+#include <chrono>
+
+Stream Serial;
+EspClass ESP;
+int hostAnalogValues[64] = {};
+int (*hostDigitalRead)(uint8_t) = nullptr;
+void (*hostDigitalWrite)(uint8_t, uint8_t) = nullptr;
+uint32_t hostCycles = 0;
+
+static uint32_t regReadZero(uint32_t) { return 0; }
+static void regWriteIgnore(uint32_t, uint32_t) {}
+uint32_t (*hostRegRead)(uint32_t) = regReadZero;
+void (*hostRegWrite)(uint32_t, uint32_t) = regWriteIgnore;
+
+void pinMode(uint8_t, uint8_t) {}
+int digitalRead(uint8_t pin) { return hostDigitalRead ? hostDigitalRead(pin) : LOW; }
+void digitalWrite(uint8_t pin, uint8_t val) { if (hostDigitalWrite) hostDigitalWrite(pin, val); }
+int analogRead(uint8_t pin) { return hostAnalogValues[pin & 63]; }
+
+unsigned long micros() {
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+unsigned long millis() { return micros() / 1000; }
+void delay(unsigned long) {}
+void delayMicroseconds(unsigned int us) { hostCycles += us * (F_CPU / 1000000); }
+void noInterrupts() {}
+void interrupts() {}
+
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        digitalWrite(clockPin, HIGH);
+        const uint8_t bit = digitalRead(dataPin) ? 1 : 0;
+        value |= bitOrder == LSBFIRST ? bit << i : bit << (7 - i);
+        digitalWrite(clockPin, LOW);
+    }
+    return value;
+}
+
+// Igual que WMath.cpp de arduino-esp32
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    const long run = inMax - inMin;
+    if (run == 0) return -1;
+    return (x - inMin) * (outMax - outMin) / run + outMin;
+}
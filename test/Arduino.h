@@ -0,0 +1,120 @@
+/**
+ * @file Arduino.h
+ * @brief Sustituto mínimo del núcleo de Arduino para compilar las pruebas en el PC.
+ *
+ * Solo declara lo que usan las cabeceras de lógica pura, SimRacing y los drivers
+ * de la célula de carga: tipos, String, Stream/Serial mudos y las funciones de pines. Las lecturas analógicas
+ * salen de hostAnalogValues[] (ver Arduino.cpp) para que cada prueba fije el
+ * valor del pin. Nada de esto se compila para el ESP32.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <string>
+#include <algorithm>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define RISING 0x01
+#define FALLING 0x02
+#define PI 3.1415926535897932384626433832795
+#define F(s) (s)
+#define F_CPU 240000000L
+
+typedef uint8_t byte;
+using std::min;
+using std::max;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class String {
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& v) : s(v) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(float v, unsigned char = 2) : s(std::to_string(v)) {}
+    String(double v, unsigned char = 2) : s(std::to_string(v)) {}
+
+    size_t length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    char operator[](size_t i) const { return s[i]; }
+    bool operator==(const String& o) const { return s == o.s; }
+    void toLowerCase() { for (char& c : s) c = (char)tolower((unsigned char)c); }
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    friend String operator+(String a, const String& b) { return a += b; }
+
+private:
+    std::string s;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    template<typename T> size_t print(const T&) { return 0; }
+    template<typename T> size_t print(const T&, int) { return 0; }
+    template<typename T> size_t println(const T&) { return 0; }
+    template<typename T> size_t println(const T&, int) { return 0; }
+    size_t println() { return 0; }
+};
+
+class Stream : public Print {
+public:
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    void setTimeout(unsigned long) {}
+    float parseFloat() { return 0; }
+    long parseInt() { return 0; }
+    void flush() {}
+    String readStringUntil(char) { return String(); }
+};
+
+extern Stream Serial;
+
+extern int hostAnalogValues[64]; // Valor que devuelve analogRead() para cada pin
+
+// digitalRead()/digitalWrite() llaman a estos si no son nulos (p.ej. un HX711 simulado)
+extern int (*hostDigitalRead)(uint8_t pin);
+extern void (*hostDigitalWrite)(uint8_t pin, uint8_t val);
+
+// Contador de ciclos simulado a F_CPU: cada consulta cuenta un ciclo y
+// delayMicroseconds() suma lo que duraría la espera. No mide tiempo real.
+extern uint32_t hostCycles;
+class EspClass {
+public:
+    uint32_t getCycleCount() { return hostCycles++; }
+};
+extern EspClass ESP;
+
+// Secciones críticas de FreeRTOS: en el PC no hacen nada
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+int analogRead(uint8_t pin);
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+void noInterrupts();
+void interrupts();
@@ -0,0 +1,18 @@
+/**
+ * @file Wire.h
+ * @brief Sustituto de TwoWire para compilar NAU7802 en el PC.
+ *
+ * Las pruebas no lo usan: hablan con el driver a través de un NAU7802Bus simulado.
+ * Solo existe para que NAU7802WireBus compile y enlace.
+ */
+#pragma once
+#include <Arduino.h>
+
+class TwoWire : public Stream {
+public:
+    bool begin(int = -1, int = -1, uint32_t = 0) { return true; }
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool = true) { return 2; } // Sin dispositivo: NACK de dirección
+    size_t requestFrom(uint16_t, size_t, bool = true) { return 0; }
+    size_t write(uint8_t) { return 1; }
+};
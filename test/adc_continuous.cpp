@@ -0,0 +1,66 @@
+/**
+ * @file adc_continuous.cpp
+ * @brief Implementación en el PC del driver de ADC continuo declarado en esp_adc/.
+ */
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include <deque>
+#include <string.h>
+
+static std::deque<uint32_t> pending; // Resultados TYPE2 ya empaquetados
+static adc_continuous_ctx_t* const HANDLE = reinterpret_cast<adc_continuous_ctx_t*>(0x1);
+static adc_cali_scheme_t* const CALI = reinterpret_cast<adc_cali_scheme_t*>(0x1);
+
+void hostAdcPush(uint8_t channel, uint16_t raw) {
+    adc_digi_output_data_t result = {};
+    result.type2.data = raw & 0xFFF;
+    result.type2.channel = channel & 0xF;
+    result.type2.unit = 0;
+    pending.push_back(result.val);
+}
+
+uint32_t hostAdcPending() { return (uint32_t)pending.size(); }
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t*, adc_continuous_handle_t* handle) {
+    pending.clear();
+    *handle = HANDLE;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t, const adc_continuous_config_t*) { return ESP_OK; }
+esp_err_t adc_continuous_start(adc_continuous_handle_t) { return ESP_OK; }
+esp_err_t adc_continuous_stop(adc_continuous_handle_t) { return ESP_OK; }
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t) { pending.clear(); return ESP_OK; }
+
+esp_err_t adc_continuous_read(adc_continuous_handle_t, uint8_t* buf, uint32_t length_max,
+                              uint32_t* out_length, uint32_t) {
+    if (pending.empty()) return ESP_ERR_TIMEOUT;
+    uint32_t n = 0;
+    while (!pending.empty() && (n + 1) * sizeof(uint32_t) <= length_max) {
+        memcpy(buf + n * sizeof(uint32_t), &pending.front(), sizeof(uint32_t));
+        pending.pop_front();
+        n++;
+    }
+    *out_length = n * sizeof(uint32_t);
+    return ESP_OK;
+}
+
+// ESP32-S3: GPIO1..10 son los canales 0..9 de ADC1 y GPIO11..20 los de ADC2
+esp_err_t adc_continuous_io_to_channel(int io_num, adc_unit_t* unit, adc_channel_t* channel) {
+    if (io_num < 1 || io_num > 20) return ESP_FAIL;
+    *unit = io_num <= 10 ? ADC_UNIT_1 : ADC_UNIT_2;
+    *channel = (adc_channel_t)((io_num - 1) % 10);
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t*, adc_cali_handle_t* handle) {
+    *handle = CALI;
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_delete_scheme_curve_fitting(adc_cali_handle_t) { return ESP_OK; }
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t, int raw, int* voltage) {
+    *voltage = raw * 3100 / 4095;
+    return ESP_OK;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file bench.h
+ * @brief Cronometraje para las medidas en el PC (make bench).
+ *
+ * Las dos variantes que se comparan se ejecutan intercaladas, pasada a pasada, y
+ * de cada una se queda la mejor: el ruido de la máquina afecta a las dos por igual.
+ * Los tiempos son del PC y solo valen para comparar variantes entre sí.
+ */
+#pragma once
+#include <chrono>
+#include <stdint.h>
+
+static constexpr uint32_t BENCH_ROUNDS = 1000000; // Llamadas por pasada
+static constexpr uint8_t BENCH_REPEATS = 21;      // Pasadas por variante
+
+static volatile long benchSink; // Destino de los resultados, para que no se eliminen
+
+template<typename F>
+static double benchPass(F& f) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++) f(i);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / BENCH_ROUNDS;
+}
+
+/** ns por llamada de `a(i)` y de `b(i)`, mejor de BENCH_REPEATS pasadas intercaladas. */
+template<typename A, typename B>
+static void benchCompare(A a, B b, double& nsA, double& nsB) {
+    nsA = nsB = 1e30;
+    for (uint8_t r = 0; r < BENCH_REPEATS; r++) {
+        const double ta = benchPass(a);
+        const double tb = benchPass(b);
+        if (ta < nsA) nsA = ta;
+        if (tb < nsB) nsB = tb;
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * @file bench_brake_scale.cpp
+ * @brief Medida en el PC del escalado del freno: camino anterior (get_value() en double
+ *        y factor float) frente a BrakeScale en punto fijo.
+ *
+ * El PC tiene FPU de doble precisión, así que aquí la diferencia es mínima: en el
+ * ESP32-S3 el double se emula por software y la FPU solo es de simple precisión.
+ * Lo que se mide es el camino por muestra completo: tara, escalado y recorte.
+ */
+#include "BrakeScale.h"
+#include "bench.h"
+#include <stdio.h>
+
+static constexpr int32_t ADC_brake = 16384;
+static constexpr float MAX_FORCE = 1000000.0f;
+static constexpr long OFFSET = 83211;
+
+// Camino anterior: HX711::get_value() devolvía double y el loop escalaba con un float
+__attribute__((noinline)) static double legacyGetValue(long code) { return (double)(code - OFFSET); }
+__attribute__((noinline)) static int32_t legacyScale(long value, float factor) {
+    return (int32_t)(float)constrain(value * factor, 0, (float)ADC_brake);
+}
+
+__attribute__((noinline)) static int32_t fixedScale(const BrakeScale& s, long code) {
+    return s.apply((int32_t)(code - OFFSET));
+}
+
+static long code(uint32_t i) { return OFFSET - 2000 + (long)((i * 2654435761u) >> 12); }
+
+int main() {
+    const float factor = ADC_brake / MAX_FORCE;
+    BrakeScale scale;
+    scale.configure(MAX_FORCE, ADC_brake);
+
+    // Mismo resultado salvo redondeo del factor (una cuenta)
+    int32_t worst = 0;
+    for (uint32_t i = 0; i < 100000; i++) {
+        const int32_t d = abs(legacyScale((long)legacyGetValue(code(i)), factor) - fixedScale(scale, code(i)));
+        if (d > worst) worst = d;
+    }
+
+    double legacy, fixed;
+    benchCompare([&](uint32_t i) { benchSink = legacyScale((long)legacyGetValue(code(i)), factor); },
+                 [&](uint32_t i) { benchSink = fixedScale(scale, code(i)); }, legacy, fixed);
+    printf("Escalado del freno: double/float %.2f ns, Q8.24 %.2f ns (diferencia máx. %ld cuentas)\n",
+           legacy, fixed, (long)worst);
+    return worst > 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file bench_decimator.cpp
+ * @brief Decimador de ContinuousADC sobre trazas sintéticas: ruido, respuesta a un
+ *        escalón y coste por conversión para cada sobremuestreo.
+ *
+ * Las conversiones pasan por el camino DMA real de AnalogDMA.cpp con el driver
+ * simulado de esp_adc/. La traza es sintética: un nivel fijo más ruido gaussiano de
+ * NOISE_LSB (del orden del ruido del ADC del ESP32-S3), y un escalón sin ruido.
+ * El sketch escanea 2 pines a 20 kHz (10 kHz por canal) y lee a ~1 kHz: entre dos
+ * fetch() llegan FETCH_EVERY conversiones por canal. Los tiempos son del PC.
+ */
+#include "SimRacing.h"
+#include "AnalogDMA.h"
+#include "bench.h"
+#include "esp_adc/adc_continuous.h"
+#include <math.h>
+#include <stdio.h>
+
+using namespace SimRacing;
+
+static const int16_t PINS[] = {1, 2}; // Canales 0 y 1 de ADC1
+static constexpr uint32_t FETCH_EVERY = 10;
+static constexpr double NOISE_LSB = 3.0;
+static constexpr double LEVEL = 2047.3;
+
+static uint32_t rngState = 12345;
+static double uniform() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return ((rngState >> 8) + 0.5) / 16777216.0;
+}
+static double gauss() { return sqrt(-2.0 * log(uniform())) * cos(2.0 * PI * uniform()); }
+
+static uint16_t code(double v) {
+    const long c = lround(v);
+    return (uint16_t)(c < 0 ? 0 : c > 4095 ? 4095 : c);
+}
+
+static void push(uint16_t a, uint16_t b) {
+    hostAdcPush(0, a);
+    hostAdcPush(1, b);
+}
+
+/** Ruido RMS de la salida, en LSB de 12 bits. */
+static double outputNoise(uint8_t log2) {
+    ContinuousADC::setOversampling(log2);
+    const double toLsb = 1.0 / (1 << (log2 / 2));
+    double sum = 0, sum2 = 0;
+    uint32_t n = 0;
+    for (uint32_t f = 0; f < 3000; f++) {
+        for (uint32_t i = 0; i < FETCH_EVERY; i++) push(code(LEVEL + NOISE_LSB * gauss()), 0);
+        int value;
+        if (f < 20 || !ContinuousADC::fetch(PINS[0], value)) continue; // Historial lleno
+        const double x = value * toLsb;
+        sum += x;
+        sum2 += x * x;
+        n++;
+    }
+    const double mean = sum / n;
+    return sqrt(sum2 / n - mean * mean);
+}
+
+/** Conversiones del canal hasta que la salida cubre el 90 % de un escalón 1000 -> 3000. */
+static uint32_t riseConversions(uint8_t log2) {
+    ContinuousADC::setOversampling(log2);
+    for (uint32_t i = 0; i < 64; i++) push(1000, 0);
+    const int target = (int)((1000 + 0.9 * 2000) * (1 << (log2 / 2)));
+    for (uint32_t i = 1; i <= 256; i++) {
+        push(3000, 0);
+        int value;
+        if (ContinuousADC::fetch(PINS[0], value) && value >= target) return i;
+    }
+    return 0;
+}
+
+int main() {
+    if (!ContinuousADC::begin(PINS, 2, 20000)) {
+        printf("Decimador: el driver simulado no arranca\n");
+        return 1;
+    }
+
+    printf("Decimador (traza sintética, ruido %.1f LSB, %u conversiones por canal entre fetch):\n",
+           NOISE_LSB, (unsigned)FETCH_EVERY);
+    for (uint8_t log2 : {0, 2, 3, 4, 6}) {
+        const double noise = outputNoise(log2);
+        const uint32_t rise = riseConversions(log2);
+
+        // Coste por conversión en poll(), una trama cada 64 conversiones. El canal 0 va
+        // directo al decimador y el 1 pasa antes por la mediana de 3.
+        ContinuousADC::setOversampling(log2);
+        ContinuousADC::setSpikeRejection(PINS[1], 50);
+        double plain, median;
+        benchCompare(
+            [](uint32_t i) {
+                hostAdcPush(0, (uint16_t)((i * 7) & 4095));
+                if ((i & 63) == 63) ContinuousADC::poll();
+            },
+            [](uint32_t i) {
+                hostAdcPush(1, (uint16_t)((i * 7) & 4095));
+                if ((i & 63) == 63) ContinuousADC::poll();
+            },
+            plain, median);
+        ContinuousADC::setSpikeRejection(PINS[1], 0);
+
+        printf("  %2ux (%u bits): ruido %.2f LSB (x%.1f menos), 90%% del escalón en %u conversiones "
+               "(%.1f ms a 10 kHz), %.2f ns/conversión (%.2f con mediana)\n",
+               1u << log2, (unsigned)ContinuousADC::resolution(), noise, NOISE_LSB / noise,
+               (unsigned)rise, rise / 10.0, plain, median);
+    }
+    ContinuousADC::end();
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file bench_filters.cpp
+ * @brief Reproducción de una traza de pedal con EmaFilter y OneEuroFilter: retardo en
+ *        los movimientos, temblor en reposo y coste por muestra.
+ *
+ * La traza es SINTÉTICA (no hay capturas reales en el repositorio): gas de 12 bits
+ * leído por loop() cada 0.8-1.6 ms, con ruido gaussiano de NOISE counts sobre un
+ * recorrido sin ruido que sirve de referencia: reposo, presión lenta hasta el 60 %
+ * en 1 s, pisotón a fondo en 60 ms, soltar en 80 ms y reposo. El One Euro usa los
+ * valores por defecto del sketch (1 Hz, beta 2.5 Hz por recorrido/s).
+ */
+#include "EmaFilter.h"
+#include "OneEuroFilter.h"
+#include "bench.h"
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+static constexpr int32_t SCALE = 4095;
+static constexpr double NOISE = 4.0;
+
+struct Sample { uint32_t us; int32_t x; double truth; };
+
+static std::vector<Sample> makeTrace() {
+    std::vector<Sample> trace;
+    uint32_t seed = 7;
+    auto uniform = [&]() { seed = seed * 1664525u + 1013904223u; return ((seed >> 8) + 0.5) / 16777216.0; };
+    // Tramos: {duración en ms, valor final en fracción del recorrido}; rampas lineales
+    const double segments[][2] = {{1000, 0}, {1000, 0.6}, {700, 0.6}, {60, 1.0}, {700, 1.0}, {80, 0}, {1000, 0}};
+    double t = 0, start = 0, level = 0;
+    for (const auto& seg : segments) {
+        const double from = level, end = start + seg[0] * 1000;
+        while (t < end) {
+            const double truth = SCALE * (from + (seg[1] - from) * (t - start) / (end - start));
+            const double noise = NOISE * sqrt(-2 * log(uniform())) * cos(2 * PI * uniform());
+            trace.push_back({(uint32_t)t, (int32_t)lround(constrain(truth + noise, 0.0, (double)SCALE)), truth});
+            t += 800 + 800 * uniform();
+        }
+        start = end;
+        level = seg[1];
+    }
+    return trace;
+}
+
+/** Instante (us) en que `v` cruza `level` subiendo (o bajando) dentro de [from, to). */
+template<typename V>
+static double crossing(const std::vector<Sample>& trace, V v, double level, uint32_t from, uint32_t to, bool rising) {
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (trace[i].us < from || trace[i].us >= to) continue;
+        if (rising ? v(i) >= level : v(i) <= level) return trace[i].us;
+    }
+    return NAN;
+}
+
+template<typename F>
+static void replay(const char* name, F& filter, const std::vector<Sample>& trace) {
+    std::vector<int32_t> out(trace.size());
+    for (size_t i = 0; i < trace.size(); i++) out[i] = filter.update(trace[i].x, trace[i].us);
+
+    auto y = [&](size_t i) { return (double)out[i]; };
+    auto r = [&](size_t i) { return trace[i].truth; };
+    const double slow = crossing(trace, y, 0.3 * SCALE, 1000000, 2000000, true) -
+                        crossing(trace, r, 0.3 * SCALE, 1000000, 2000000, true);
+    const double stab = crossing(trace, y, 0.8 * SCALE, 2700000, 3500000, true) -
+                        crossing(trace, r, 0.8 * SCALE, 2700000, 3500000, true);
+    const double release = crossing(trace, y, 0.2 * SCALE, 3460000, 4600000, false) -
+                           crossing(trace, r, 0.2 * SCALE, 3460000, 4600000, false);
+
+    // Temblor: desviación de la salida en los tramos quietos, ya asentada
+    double sum2 = 0;
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    uint32_t n = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+        const uint32_t t = trace[i].us;
+        if (!((t > 2300000 && t < 2700000) || (t > 3300000 && t < 3460000))) continue;
+        const double e = out[i] - trace[i].truth;
+        sum2 += e * e;
+        n++;
+        if (t < 2700000) { lo = min(lo, out[i]); hi = max(hi, out[i]); }
+    }
+    printf("  %-18s retardo: lento %5.1f ms, pisotón %5.1f ms, soltar %5.1f ms; "
+           "temblor %.2f RMS, %d pico a pico\n",
+           name, slow / 1000, stab / 1000, release / 1000, sqrt(sum2 / n), hi - lo);
+}
+
+int main() {
+    const std::vector<Sample> trace = makeTrace();
+    printf("Filtros sobre traza sintética (%zu muestras, ruido %.0f cuentas RMS):\n", trace.size(), NOISE);
+
+    for (uint16_t hz : {5, 10, 20}) {
+        EmaFilter ema;
+        ema.setCutoffHz(hz);
+        char name[24];
+        snprintf(name, sizeof(name), "EMA %u Hz", hz);
+        replay(name, ema, trace);
+    }
+    OneEuroFilter euro;
+    euro.configure(10, 2500, SCALE);
+    replay("One Euro 1 Hz/2.5", euro, trace);
+
+    // Coste por muestra, con el dt de la traza
+    EmaFilter ema;
+    ema.setCutoffHz(10);
+    OneEuroFilter euroBench;
+    euroBench.configure(10, 2500, SCALE);
+    const size_t n = trace.size();
+    double nsEma, nsEuro;
+    benchCompare([&](uint32_t i) { const Sample& s = trace[i % n]; benchSink = ema.update(s.x, i * 1000u); },
+                 [&](uint32_t i) { const Sample& s = trace[i % n]; benchSink = euroBench.update(s.x, i * 1000u); },
+                 nsEma, nsEuro);
+    printf("  coste: EMA %.2f ns/muestra, One Euro %.2f ns/muestra\n", nsEma, nsEuro);
+    return 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file bench_hx711_fast.cpp
+ * @brief Coste por lectura de HX711FastBackend frente a HX711GpioBackend, contado sobre
+ *        el HX711 simulado de hx711_mock.h.
+ *
+ * No se cronometra: en el PC los pines son llamadas a funciones y el backend GPIO se
+ * compila sin las esperas de shiftInSlow(). Se cuentan los accesos a pines/registros
+ * de cada lectura y los ciclos de espera dentro de la sección crítica: los de
+ * HX711Fast se miden con el contador de ciclos simulado (hold() lo consulta); los del
+ * backend GPIO salen de sus delayMicroseconds(1), dos por pulso, en el ESP32.
+ * La duración real en el chip la da get_read_cycles() en el diagnóstico del sketch.
+ */
+#include "hx711_mock.h"
+#include "HX711Fast.h"
+#include <stdio.h>
+
+static constexpr uint32_t CYCLES_PER_US = F_CPU / 1000000;
+
+int main() {
+    SimulatedHX711 chip(4, 5);
+    HX711FastBackend<4, 5> fast;
+    HX711GpioBackend gpio;
+    fast.begin(4, 5);
+    gpio.begin(4, 5);
+
+    const char* gains[] = {"", "x128", "x32", "x64"};
+    for (byte gain = 1; gain <= 3; gain++) {
+        chip.convert(0xA5A5A5);
+        const uint32_t start = hostCycles;
+        fast.read_raw(gain);
+        const uint32_t fastCycles = hostCycles - start;
+        const int fastAccesses = chip.regAccesses;
+
+        chip.convert(0xA5A5A5);
+        gpio.read_raw(gain);
+        const int gpioCalls = chip.pinCalls;
+        const uint32_t gpioWait = (24 + gain) * 2 * CYCLES_PER_US;
+
+        printf("HX711 %s (%d pulsos): Fast %d accesos a registro, %lu ciclos; "
+               "GPIO %d llamadas digitalRead/Write, >= %lu ciclos de espera en el ESP32\n",
+               gains[gain], 24 + gain, fastAccesses, (unsigned long)fastCycles, gpioCalls,
+               (unsigned long)gpioWait);
+    }
+    return 0;
+}
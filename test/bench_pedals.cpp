@@ -0,0 +1,85 @@
+/**
+ * @file bench_pedals.cpp
+ * @brief Medidas en el PC de StaticPedals frente a ThreePedals y del escalado con
+ *        recíproco de AnalogInput::getPosition frente a map().
+ *
+ * Que las dos variantes dan lo mismo lo comprueban test_static_pedals y
+ * test_analog_input; aquí solo se mide.
+ */
+#include "SimRacing.h"
+#include "bench.h"
+#include <stdio.h>
+
+using namespace SimRacing;
+
+static constexpr PinNum PIN_GAS = 1, PIN_BRAKE = 2, PIN_CLUTCH = 3;
+static constexpr long OUT_MAX = 16383; // 14 bits: gas/embrague con sobremuestreo x16
+static void setPins(uint32_t i) {
+    hostAnalogValues[PIN_GAS] = (int)(i * 7 & 4095);
+    hostAnalogValues[PIN_BRAKE] = (int)(i * 11 & 4095);
+    hostAnalogValues[PIN_CLUTCH] = (int)(i * 13 & 4095);
+}
+
+// El remap() de SimRacing.cpp con la división de map(), como antes del recíproco
+__attribute__((noinline)) // Fuera de línea, como getPosition() en SimRacing.cpp
+static long mapRemap(long value, long inMin, long inMax, long outMin, long outMax) {
+    if (inMin > inMax) {
+        std::swap(inMin, inMax);
+        value = inMax - value + inMin;
+    }
+    if (value <= inMin) return outMin;
+    if (value >= inMax) return outMax;
+    return map(value, inMin, inMax, outMin, outMax);
+}
+
+static int benchScaler() {
+    // La exactitud frente a map() la comprueba test_analog_input; aquí solo se mide
+    AnalogInput input(UnusedPin);
+    input.setCalibration({300, 3800});
+    double reciprocal, division;
+    benchCompare(
+        [&](uint32_t i) {
+            input.setPosition((int)(i & 4095));
+            benchSink = input.getPosition(0, OUT_MAX);
+        },
+        [&](uint32_t i) {
+            input.setPosition((int)(i & 4095));
+            benchSink = mapRemap(input.getPositionRaw(), input.getMin(), input.getMax(), 0, OUT_MAX);
+        },
+        reciprocal, division);
+    printf("getPosition: recíproco %.2f ns, map() %.2f ns\n", reciprocal, division);
+    return 0;
+}
+
+static int benchPedals() {
+    // Estáticos como los globales del sketch: Peripheral no inicializa su puntero al detector
+    static ThreePedals dynamicPedals(PIN_GAS, PIN_BRAKE, PIN_CLUTCH);
+    static StaticPedals<PIN_GAS, PIN_BRAKE, PIN_CLUTCH> staticPedals;
+    const AnalogInput::Calibration gas = {300, 3800}, brake = {0, 4095}, clutch = {3900, 200};
+    dynamicPedals.setCalibration(gas, brake, clutch);
+    staticPedals.setCalibration(gas, brake, clutch);
+
+    Pedals& dynamicBase = dynamicPedals; // Como se usaba en el sketch: llamada virtual a updateState
+    double dyn, stat;
+    benchCompare([&](uint32_t i) { setPins(i); benchSink = dynamicBase.update(); },
+                 [&](uint32_t i) { setPins(i); benchSink = staticPedals.update(); }, dyn, stat);
+    printf("update() de 3 pedales: ThreePedals %.2f ns, StaticPedals %.2f ns\n", dyn, stat);
+
+    // Un frame del sketch: update() y, para gas y embrague, posición cruda y escalada
+    auto frame = [](auto& pedals, uint32_t i) {
+        setPins(i);
+        long acc = pedals.update();
+        for (const Pedal id : {Gas, Clutch}) acc += pedals.getPositionRaw(id) + pedals.getPosition(id, 0, OUT_MAX);
+        benchSink = acc;
+    };
+    ThreePedals& dynamicRef = dynamicPedals;
+    double dynFrame, statFrame;
+    benchCompare([&](uint32_t i) { frame(dynamicRef, i); }, [&](uint32_t i) { frame(staticPedals, i); },
+                 dynFrame, statFrame);
+    printf("frame del sketch: ThreePedals %.2f ns, StaticPedals %.2f ns\n", dynFrame, statFrame);
+    return 0;
+}
+
+int main() {
+    return benchPedals() | benchScaler();
+}
@@ -0,0 +1,11 @@
+/**
+ * @file adc_cali.h
+ * @brief Calibración de ADC simulada: curva lineal de 0 a 3100 mV.
+ */
+#pragma once
+#include "esp_adc/adc_continuous.h"
+
+typedef struct adc_cali_scheme_t* adc_cali_handle_t;
+typedef enum { ADC_BITWIDTH_DEFAULT = 0, ADC_BITWIDTH_12 = 12 } adc_bitwidth_t;
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int* voltage);
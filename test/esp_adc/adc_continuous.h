@@ -0,0 +1,66 @@
+/**
+ * @file adc_continuous.h
+ * @brief Driver de ADC continuo simulado para compilar el camino DMA de AnalogDMA.cpp en el PC.
+ *
+ * Mismos tipos y funciones que el de ESP-IDF 5 para el ESP32-S3 (ADC1 en GPIO1..10).
+ * Las conversiones no vienen de ningún hardware: las pruebas las encolan con
+ * hostAdcPush() y adc_continuous_read() las entrega en formato TYPE2.
+ */
+#pragma once
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef struct adc_continuous_ctx_t* adc_continuous_handle_t;
+typedef enum { ADC_UNIT_1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_CHANNEL_0 } adc_channel_t;
+typedef enum { ADC_ATTEN_DB_0, ADC_ATTEN_DB_2_5, ADC_ATTEN_DB_6, ADC_ATTEN_DB_12 } adc_atten_t;
+typedef enum { ADC_CONV_SINGLE_UNIT_1 = 1 } adc_digi_convert_mode_t;
+typedef enum { ADC_DIGI_OUTPUT_FORMAT_TYPE1, ADC_DIGI_OUTPUT_FORMAT_TYPE2 } adc_digi_output_format_t;
+
+typedef struct {
+    uint32_t max_store_buf_size;
+    uint32_t conv_frame_size;
+    struct { uint32_t flush_pool : 1; } flags;
+} adc_continuous_handle_cfg_t;
+
+typedef struct { uint8_t atten; uint8_t channel; uint8_t unit; uint8_t bit_width; } adc_digi_pattern_config_t;
+
+typedef struct {
+    uint32_t pattern_num;
+    adc_digi_pattern_config_t* adc_pattern;
+    uint32_t sample_freq_hz;
+    adc_digi_convert_mode_t conv_mode;
+    adc_digi_output_format_t format;
+} adc_continuous_config_t;
+
+typedef struct {
+    union {
+        struct {
+            uint32_t data : 12;
+            uint32_t reserved12 : 1;
+            uint32_t channel : 4;
+            uint32_t unit : 1;
+            uint32_t reserved17_31 : 14;
+        } type2;
+        uint32_t val;
+    };
+} adc_digi_output_data_t;
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t* cfg, adc_continuous_handle_t* handle);
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t* config);
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t* buf, uint32_t length_max,
+                              uint32_t* out_length, uint32_t timeout_ms);
+esp_err_t adc_continuous_io_to_channel(int io_num, adc_unit_t* unit, adc_channel_t* channel);
+
+/** Encola una conversión del canal de ADC1 `channel` (GPIO channel + 1). */
+void hostAdcPush(uint8_t channel, uint16_t raw);
+
+/** Conversiones encoladas que aún no ha leído el driver. */
+uint32_t hostAdcPending();
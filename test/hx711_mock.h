@@ -0,0 +1,148 @@
+/**
+ * @file hx711_mock.h
+ * @brief HX711 simulados para las pruebas.
+ *
+ * MockHX711Backend sustituye al transporte: entrega palabras de 24 bits de una cola.
+ * is_ready() imita DOUT: cuenta como "no listo" las primeras busyPolls consultas de
+ * cada conversión y mientras la cola esté vacía. read_raw() registra cuántos pulsos
+ * de ganancia pidió el driver para cada lectura.
+ *
+ * SimulatedHX711 simula el chip a nivel de pines para probar los backends reales.
+ */
+#pragma once
+#include "HX711.h"
+#include "soc/gpio_reg.h"
+#include <deque>
+#include <vector>
+
+class MockHX711Backend : public HX711Backend {
+public:
+    std::deque<uint32_t> words;      ///< Próximas palabras que "convierte" el chip
+    std::vector<byte> gainPulses;    ///< Pulsos extra pedidos en cada read_raw()
+    std::vector<bool> clockLevels;   ///< Niveles estáticos de PD_SCK en orden
+    int busyPolls = 0;               ///< Consultas "no listo" antes de cada conversión
+    int polls = 0;                   ///< is_ready() llamadas en total
+    int readsWhileBusy = 0;          ///< read_raw() sin que is_ready() diera true antes
+    byte dout = 0xFF, sck = 0xFF;
+
+    void begin(byte d, byte s) override { dout = d; sck = s; }
+
+    bool is_ready() override {
+        polls++;
+        if (words.empty()) return false;
+        if (busyLeft > 0) { busyLeft--; return false; }
+        armed = true;
+        return true;
+    }
+
+    uint32_t read_raw(byte gain_pulses) override {
+        if (!armed || words.empty()) readsWhileBusy++;
+        armed = false;
+        busyLeft = busyPolls;
+        gainPulses.push_back(gain_pulses);
+        if (words.empty()) return 0xFFFFFF;
+        const uint32_t w = words.front();
+        words.pop_front();
+        return w;
+    }
+
+    void set_clock(bool high) override { clockLevels.push_back(high); }
+
+    void push(uint32_t word) {
+        if (words.empty()) busyLeft = busyPolls;
+        words.push_back(word);
+    }
+
+private:
+    int busyLeft = 0;
+    bool armed = false;
+};
+
+/**
+ * Chip HX711 visto desde sus pines. Tras convert() DOUT está bajo; cada flanco de
+ * subida de PD_SCK saca el siguiente bit (MSB primero) y a partir del 25 DOUT queda
+ * alto, de modo que los pulsos de más fijan la ganancia. Responde a la vez a
+ * digitalRead()/digitalWrite() y a los registros GPIO de HX711Fast, cuenta los
+ * accesos de cada tipo y mide los semiperiodos de PD_SCK con hostCycles.
+ * Solo puede haber uno activo.
+ */
+class SimulatedHX711 {
+public:
+    uint32_t word = 0;
+    int pulses = 0;            ///< Flancos de subida desde convert()
+    int pinCalls = 0;          ///< digitalRead/digitalWrite sobre DOUT o PD_SCK
+    int regAccesses = 0;       ///< Lecturas de GPIO_IN y escrituras W1TS/W1TC
+    uint32_t minHigh = UINT32_MAX, minLow = UINT32_MAX; ///< Semiperiodos más cortos, en ciclos
+    bool sck = false;
+
+    SimulatedHX711(uint8_t dout, uint8_t sck) : doutPin(dout), sckPin(sck) {
+        active = this;
+        hostDigitalRead = pinRead;
+        hostDigitalWrite = pinWrite;
+        hostRegRead = regRead;
+        hostRegWrite = regWrite;
+    }
+    ~SimulatedHX711() {
+        active = nullptr;
+        hostDigitalRead = nullptr;
+        hostDigitalWrite = nullptr;
+        hostRegRead = [](uint32_t) -> uint32_t { return 0; };
+        hostRegWrite = [](uint32_t, uint32_t) {};
+    }
+
+    /** Deja lista una conversión y pone a cero los contadores. */
+    void convert(uint32_t w) {
+        word = w & 0xFFFFFF;
+        pulses = pinCalls = regAccesses = 0;
+        minHigh = minLow = UINT32_MAX;
+    }
+
+    bool dout() const { return pulses == 0 ? false : pulses > 24 ? true : (word >> (24 - pulses)) & 1; }
+
+private:
+    uint8_t doutPin, sckPin;
+    uint32_t edgeAt = 0;
+    static inline SimulatedHX711* active = nullptr;
+
+    void clock(bool high) {
+        if (high == sck) return;
+        const uint32_t now = hostCycles;
+        if (pulses > 0 || high == false) {
+            uint32_t& shortest = high ? minLow : minHigh;
+            if (now - edgeAt < shortest) shortest = now - edgeAt;
+        }
+        edgeAt = now;
+        sck = high;
+        if (high) pulses++;
+    }
+
+    static uint32_t bankMask(uint8_t pin) { return 1UL << (pin & 31); }
+
+    static int pinRead(uint8_t pin) {
+        if (pin != active->doutPin) return LOW;
+        active->pinCalls++;
+        return active->dout() ? HIGH : LOW;
+    }
+    static void pinWrite(uint8_t pin, uint8_t val) {
+        if (pin != active->sckPin) return;
+        active->pinCalls++;
+        active->clock(val == HIGH);
+    }
+    static uint32_t regRead(uint32_t reg) {
+        const uint8_t pin = active->doutPin;
+        if (reg != (pin < 32 ? (uint32_t)GPIO_IN_REG : (uint32_t)GPIO_IN1_REG)) return 0;
+        active->regAccesses++;
+        return active->dout() ? bankMask(pin) : 0;
+    }
+    static void regWrite(uint32_t reg, uint32_t value) {
+        const uint8_t pin = active->sckPin;
+        if (!(value & bankMask(pin))) return;
+        if (reg == (pin < 32 ? (uint32_t)GPIO_OUT_W1TS_REG : (uint32_t)GPIO_OUT1_W1TS_REG)) {
+            active->regAccesses++;
+            active->clock(true);
+        } else if (reg == (pin < 32 ? (uint32_t)GPIO_OUT_W1TC_REG : (uint32_t)GPIO_OUT1_W1TC_REG)) {
+            active->regAccesses++;
+            active->clock(false);
+        }
+    }
+};
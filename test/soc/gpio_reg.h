@@ -0,0 +1,14 @@
+/**
+ * @file gpio_reg.h
+ * @brief Direcciones de los registros GPIO del ESP32-S3 que usa HX711Fast.h.
+ */
+#pragma once
+#include "soc/soc.h"
+
+#define DR_REG_GPIO_BASE    0x60004000
+#define GPIO_OUT_W1TS_REG   (DR_REG_GPIO_BASE + 0x0008)
+#define GPIO_OUT_W1TC_REG   (DR_REG_GPIO_BASE + 0x000C)
+#define GPIO_OUT1_W1TS_REG  (DR_REG_GPIO_BASE + 0x0014)
+#define GPIO_OUT1_W1TC_REG  (DR_REG_GPIO_BASE + 0x0018)
+#define GPIO_IN_REG         (DR_REG_GPIO_BASE + 0x003C)
+#define GPIO_IN1_REG        (DR_REG_GPIO_BASE + 0x0040)
@@ -0,0 +1,15 @@
+/**
+ * @file soc.h
+ * @brief Sustituto de soc/soc.h: los accesos a registro pasan por hostRegRead/hostRegWrite.
+ *
+ * Así HX711Fast.h compila en el PC y cada prueba decide qué hay detrás de los
+ * registros GPIO (ver hx711_mock.h). Por defecto se leen ceros y se ignoran escrituras.
+ */
+#pragma once
+#include <stdint.h>
+
+extern uint32_t (*hostRegRead)(uint32_t reg);
+extern void (*hostRegWrite)(uint32_t reg, uint32_t value);
+
+#define REG_READ(r) hostRegRead(r)
+#define REG_WRITE(r, v) hostRegWrite((r), (v))
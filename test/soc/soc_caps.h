@@ -0,0 +1,11 @@
+/**
+ * @file soc_caps.h
+ * @brief Capacidades del ADC del ESP32-S3 que usa AnalogDMA.cpp.
+ */
+#pragma once
+
+#define SOC_ADC_DMA_SUPPORTED 1
+#define SOC_ADC_DIGI_MAX_BITWIDTH 12
+#define SOC_ADC_DIGI_RESULT_BYTES 4
+#define SOC_ADC_SAMPLE_FREQ_THRES_LOW 611
+#define SOC_ADC_SAMPLE_FREQ_THRES_HIGH 83333
@@ -0,0 +1,38 @@
+/**
+ * @file test.h
+ * @brief Aserciones mínimas para las pruebas en el PC, sin dependencias.
+ *
+ * Cada prueba es un ejecutable: las macros cuentan los fallos, imprimen dónde
+ * ocurrieron y testResult() devuelve el código de salida para make.
+ */
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(cond) do { \
+        testChecks++; \
+        if (!(cond)) { testFailures++; printf("%s:%d: fallo: %s\n", __FILE__, __LINE__, #cond); } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        testChecks++; \
+        const long long va_ = (long long)(a), vb_ = (long long)(b); \
+        if (va_ != vb_) { testFailures++; printf("%s:%d: fallo: %s == %s (%lld != %lld)\n", \
+                                                __FILE__, __LINE__, #a, #b, va_, vb_); } \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol) do { \
+        testChecks++; \
+        const long long va_ = (long long)(a), vb_ = (long long)(b); \
+        if (llabs(va_ - vb_) > (long long)(tol)) { testFailures++; \
+            printf("%s:%d: fallo: %s ~ %s +- %s (%lld, %lld)\n", __FILE__, __LINE__, #a, #b, #tol, va_, vb_); } \
+    } while (0)
+
+/** Resumen de la prueba; devolverlo desde main(). */
+static int testResult(const char* name) {
+    printf("%s: %d comprobaciones, %d fallos\n", name, testChecks, testFailures);
+    return testFailures ? 1 : 0;
+}
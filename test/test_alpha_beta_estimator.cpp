@@ -0,0 +1,86 @@
+/**
+ * @file test_alpha_beta_estimator.cpp
+ * @brief Pruebas de AlphaBetaEstimator: seguimiento de rampas, extrapolación acotada y huecos.
+ */
+#include "test.h"
+#include "AlphaBetaEstimator.h"
+
+static constexpr int32_t SCALE = 65535;
+static constexpr uint32_t PERIOD_US = 12500; // HX711 a 80 muestras/s
+static constexpr uint16_t ALPHA = 26214;     // 0.8
+static constexpr uint16_t BETA = 9830;       // 0.3
+
+static AlphaBetaEstimator make(int32_t overshoot = SCALE / 32) {
+    AlphaBetaEstimator e;
+    e.configure(ALPHA, BETA, overshoot, SCALE);
+    return e;
+}
+
+static void testStaticValue() {
+    AlphaBetaEstimator e = make();
+    uint32_t t = 0;
+    for (int i = 0; i < 50; i++, t += PERIOD_US) e.update(20000, t);
+    CHECK_EQ(e.estimate(t), 20000);
+    CHECK_EQ(e.velocity(), 0);
+    CHECK_NEAR(e.interval(), PERIOD_US, 10);
+}
+
+static void testRampLocksVelocity() {
+    // Rampa de 40000 cuentas/s: la velocidad converge y la estimación entre muestras va por delante
+    AlphaBetaEstimator e = make();
+    uint32_t t = 0;
+    int32_t z = 0;
+    for (int i = 0; i < 40; i++, t += PERIOD_US) {
+        z = (int32_t)((int64_t)t * 40000 / 1000000);
+        e.update(z, t);
+    }
+    t -= PERIOD_US;
+    CHECK_NEAR(e.velocity(), 40000, 400);
+    const uint32_t mid = t + PERIOD_US / 2;
+    CHECK_NEAR(e.estimate(mid), z + 250, 10); // 6.25 ms a 40000 cuentas/s
+}
+
+static void testLeadLimitedToOneInterval() {
+    // Sin muestras nuevas se extrapola como mucho un intervalo y, pasados 4, nada
+    AlphaBetaEstimator e = make(SCALE);
+    uint32_t t = 0;
+    int32_t z = 0;
+    for (int i = 0; i < 40; i++, t += PERIOD_US) e.update(z = i * 500, t);
+    t -= PERIOD_US;
+    const int32_t oneInterval = e.estimate(t + PERIOD_US);
+    CHECK_EQ(e.estimate(t + 3 * PERIOD_US), oneInterval);
+    CHECK_NEAR(e.estimate(t + 5 * PERIOD_US), z, 5);
+}
+
+static void testOvershootAndRange() {
+    // Al soltar de golpe la extrapolación no pasa de `overshoot` ni sale de 0..fullScale
+    AlphaBetaEstimator e = make(100);
+    uint32_t t = 0;
+    for (int i = 0; i < 20; i++, t += PERIOD_US) e.update(SCALE - 20 * 1000 + i * 1000, t);
+    t -= PERIOD_US;
+    CHECK(e.estimate(t + PERIOD_US) <= SCALE);
+    for (int i = 0; i < 3; i++) e.update(i == 0 ? 30000 : 0, t += PERIOD_US);
+    const int32_t out = e.estimate(t + PERIOD_US / 2);
+    CHECK(out >= 0);
+    CHECK(out <= 100);
+}
+
+static void testGapResetsVelocity() {
+    AlphaBetaEstimator e = make();
+    uint32_t t = 0;
+    for (int i = 0; i < 20; i++, t += PERIOD_US) e.update(i * 1000, t);
+    CHECK(e.velocity() > 0);
+    t += AlphaBetaEstimator::MAX_DT_US + 1;
+    e.update(5000, t);
+    CHECK_EQ(e.velocity(), 0);
+    CHECK_EQ(e.estimate(t + PERIOD_US), 5000);
+}
+
+int main() {
+    testStaticValue();
+    testRampLocksVelocity();
+    testLeadLimitedToOneInterval();
+    testOvershootAndRange();
+    testGapResetsVelocity();
+    return testResult("AlphaBetaEstimator");
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_analog_dma.cpp
+ * @brief Pruebas de ContinuousADC sobre el driver simulado: decimación, crecimiento
+ *        de bits y alcance de la mediana de 3 frente a cortes del cursor.
+ */
+#include "test.h"
+#include "SimRacing.h"
+#include "AnalogDMA.h"
+#include "esp_adc/adc_continuous.h"
+
+using namespace SimRacing;
+
+static const int16_t PINS[] = {1, 2}; // Canales 0 y 1 de ADC1
+static constexpr uint8_t LOG2 = 4;    // 16x, como el sketch
+static constexpr int LEVEL = 3000;
+static constexpr int OUT = LEVEL << (LOG2 / 2); // Nivel en la salida de 14 bits
+
+static void feed(uint16_t raw, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) hostAdcPush(0, raw);
+}
+
+static int fetch() {
+    int value = -1;
+    ContinuousADC::fetch(PINS[0], value);
+    return value;
+}
+
+static void testRejectsOtherPins() {
+    const int16_t pins[] = {1, 11, 1, -1}; // 11 es de ADC2; 1 repetido
+    CHECK(ContinuousADC::begin(pins, 4, 20000));
+    CHECK(ContinuousADC::handles(1));
+    CHECK(!ContinuousADC::handles(11));
+    int value;
+    CHECK(!ContinuousADC::fetch(1, value)); // Aún no ha llegado nada
+    ContinuousADC::end();
+    CHECK(!ContinuousADC::handles(1));
+}
+
+static void testDecimationAndBitGrowth() {
+    CHECK(ContinuousADC::begin(PINS, 2, 20000));
+    ContinuousADC::setOversampling(LOG2);
+    CHECK_EQ(ContinuousADC::resolution(), 14);
+
+    // Durante el llenado se promedia sobre lo que hay
+    feed(1000, 1);
+    feed(2000, 1);
+    CHECK_EQ(fetch(), 1500 << 2);
+
+    // Con el historial lleno: media de las 16 últimas con 2 bits extra
+    feed(1001, 8);
+    feed(1002, 8);
+    CHECK_EQ(fetch(), (8 * 1001 + 8 * 1002) >> 2);
+    CHECK_EQ(ContinuousADC::conversions(), 18);
+
+    // El otro canal no se mezcla
+    hostAdcPush(1, 4095);
+    int other;
+    CHECK(ContinuousADC::fetch(PINS[1], other));
+    CHECK_EQ(other, 4095 << 2);
+    ContinuousADC::end();
+}
+
+/** Salida mínima durante y después de un corte a 0 de `n` conversiones. */
+static int dropoutFloor(uint32_t n, uint32_t& recovered) {
+    feed(LEVEL, 32);
+    int lowest = fetch();
+    feed(0, n);
+    recovered = 0;
+    for (uint32_t i = 1; i <= 32; i++) {
+        lowest = min(lowest, fetch());
+        feed(LEVEL, 1);
+        if (!recovered && i > n && fetch() == OUT) recovered = i;
+    }
+    return lowest;
+}
+
+static void testMedianWindow() {
+    CHECK(ContinuousADC::begin(PINS, 2, 20000));
+    ContinuousADC::setOversampling(LOG2);
+    ContinuousADC::setSpikeRejection(PINS[0], 400);
+    uint32_t recovered;
+
+    // Una conversión: la mediana la quita entera
+    CHECK_EQ(dropoutFloor(1, recovered), OUT);
+    CHECK_EQ(ContinuousADC::spikeCount(PINS[0]), 1);
+
+    // Dos y tres conversiones (200-300 us) pasan la mediana: el boxcar las deja en n/16
+    // de su altura y desaparecen cuando salen del historial
+    for (uint32_t n : {2u, 3u}) {
+        const int floor = dropoutFloor(n, recovered);
+        CHECK_EQ(floor, OUT - (int)(n * LEVEL) / (1 << (LOG2 - LOG2 / 2)));
+        CHECK(recovered > 0 && recovered <= (1u << LOG2) + 1);
+    }
+    CHECK_EQ(ContinuousADC::spikeCount(PINS[0]), 1); // Los cortes largos no cuentan como pico
+
+    // Sin mediana el corte de una conversión también llega, diluido
+    ContinuousADC::setSpikeRejection(PINS[0], 0);
+    CHECK_EQ(dropoutFloor(1, recovered), OUT - LEVEL / 4);
+    ContinuousADC::end();
+}
+
+static void testLinearizationTable() {
+    CHECK(ContinuousADC::begin(PINS, 2, 20000));
+    CHECK(ContinuousADC::setLinearization(true));
+    CHECK(ContinuousADC::linearized());
+    ContinuousADC::setOversampling(0);
+    feed(0, 1);
+    CHECK_EQ(fetch(), 0);
+    feed(4095, 1);
+    CHECK_EQ(fetch(), 4095); // Los extremos conservan su código
+    CHECK(!ContinuousADC::setLinearization(false));
+    CHECK(!ContinuousADC::linearized());
+    ContinuousADC::end();
+}
+
+int main() {
+    testRejectsOtherPins();
+    testDecimationAndBitGrowth();
+    testMedianWindow();
+    testLinearizationTable();
+    return testResult("ContinuousADC");
+}
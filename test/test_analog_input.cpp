@@ -0,0 +1,80 @@
+/**
+ * @file test_analog_input.cpp
+ * @brief Pruebas de AnalogInput::getPosition: el escalado con recíproco da
+ *        exactamente lo mismo que remap() con map() en todo el rango de entrada.
+ */
+#include "test.h"
+#include "SimRacing.h"
+
+using namespace SimRacing;
+
+// remap() de SimRacing.cpp, con la división de map()
+static long mapRemap(long value, long inMin, long inMax, long outMin, long outMax) {
+    if (inMin > inMax) {
+        std::swap(inMin, inMax);
+        value = inMax - value + inMin;
+    }
+    if (value <= inMin) return outMin;
+    if (value >= inMax) return outMax;
+    return map(value, inMin, inMax, outMin, outMax);
+}
+
+// Cuenta las entradas (todo el rango del ADC y algo por fuera) que difieren de remap()
+static uint32_t mismatches(AnalogInput& input, AnalogInput::Calibration cal, long outMin, long outMax, int inputMax) {
+    input.setCalibration(cal);
+    uint32_t bad = 0;
+    for (int raw = -8; raw <= inputMax + 8; raw++) {
+        input.setPosition(raw);
+        if (input.getPosition(outMin, outMax) != mapRemap(raw, cal.min, cal.max, outMin, outMax)) {
+            if (!bad) printf("  %d..%d -> %ld..%ld, raw %d: %ld, map() %ld\n", cal.min, cal.max, outMin, outMax,
+                             raw, input.getPosition(outMin, outMax), mapRemap(raw, cal.min, cal.max, outMin, outMax));
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static void testFixedCases() {
+    AnalogInput input(UnusedPin);
+    const AnalogInput::Calibration cals[] = {
+        {300, 3800}, {3800, 300}, {0, 4095}, {4095, 0}, {1000, 1001}, {2000, 2000}, {0, 16383}, {16383, 200},
+    };
+    const long ranges[][2] = {
+        {0, 4095}, {0, 16383}, {16383, 0}, {0, 100}, {-32768, 32767}, {32767, -32768}, {0, 1023}, {0, 65535}, {5, 5},
+    };
+    for (const auto& cal : cals) {
+        for (const auto& r : ranges) CHECK_EQ(mismatches(input, cal, r[0], r[1], 16383), 0);
+    }
+}
+
+static void testRandomCalibrations() {
+    // Calibraciones y rangos al azar (deterministas) sobre un ADC de 12 bits
+    AnalogInput input(UnusedPin);
+    uint32_t seed = 12345;
+    auto next = [&](uint32_t mod) { seed = seed * 1664525u + 1013904223u; return (long)((seed >> 8) % mod); };
+    uint32_t bad = 0;
+    for (int i = 0; i < 300; i++) {
+        const AnalogInput::Calibration cal = {(int)next(4096), (int)next(4096)};
+        const long a = next(200000) - 100000, b = next(200000) - 100000;
+        bad += mismatches(input, cal, a, b, 4095);
+    }
+    CHECK_EQ(bad, 0);
+}
+
+static void testDefaultRange() {
+    AnalogInput input(UnusedPin);
+    input.setCalibration({100, 900});
+    input.setPosition(500);
+    CHECK_EQ(input.getPosition(), mapRemap(500, 100, 900, AnalogInput::Min, AnalogInput::Max));
+    input.setPosition(50);
+    CHECK_EQ(input.getPosition(), AnalogInput::Min);
+    input.setPosition(950);
+    CHECK_EQ(input.getPosition(), AnalogInput::Max);
+}
+
+int main() {
+    testFixedCases();
+    testRandomCalibrations();
+    testDefaultRange();
+    return testResult("AnalogInput");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_auto_zero.cpp
+ * @brief Pruebas de AutoZero: tara inicial, seguimiento de deriva y pie apoyado.
+ */
+#include "test.h"
+#include "AutoZero.h"
+
+static constexpr uint32_t PERIOD_US = 100000; // 10 muestras/s
+static constexpr int32_t BAND = 2000;         // 2 % de un fondo de 100000
+static constexpr int32_t SIGMA = BAND / 4;
+
+// Ruido determinista de +-20 cuentas
+static int32_t noise(uint32_t i) { return (int32_t)((i * 2654435761u) >> 24) % 41 - 20; }
+
+struct Feeder {
+    AutoZero zero;
+    uint32_t t = 0;
+    uint32_t n = 0;
+
+    Feeder() {
+        zero.begin(10);
+        zero.setIdleBand(BAND, SIGMA);
+    }
+    void feed(int32_t code, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++, t += PERIOD_US) zero.update(code + noise(n++), t);
+    }
+};
+
+static void testInitialTare() {
+    AutoZero z;
+    z.begin(4);
+    CHECK(!z.ready());
+    CHECK(!z.update(1000, 0));
+    CHECK(!z.update(1002, 1));
+    CHECK(!z.update(998, 2));
+    CHECK(z.update(1000, 3)); // La cuarta fija el offset
+    CHECK(z.ready());
+    CHECK_EQ(z.offset(), 1000);
+}
+
+static void testTareRequest() {
+    Feeder f;
+    f.feed(50000, 100);
+    CHECK_NEAR(f.zero.offset(), 50000, 20);
+    f.zero.requestTare();
+    f.feed(60000, 1);
+    CHECK(!f.zero.ready());
+    f.feed(60000, 10);
+    CHECK(f.zero.ready());
+    CHECK_NEAR(f.zero.offset(), 60000, 20);
+}
+
+static void testTracksSlowDrift() {
+    // 300 cuentas/min durante 20 min: el offset va detrás a menos de sigma
+    Feeder f;
+    f.feed(50000, 10);
+    int32_t maxErr = 0;
+    for (uint32_t i = 0; i < 20 * 600; i++) {
+        const int32_t base = 50000 + (int32_t)(i / 2); // 0.5 cuentas por muestra
+        f.feed(base, 1);
+        if (i > 1200) maxErr = max(maxErr, abs(base - f.zero.offset()));
+    }
+    CHECK(maxErr < SIGMA);
+    CHECK(f.zero.driftPerMinute() > 200 && f.zero.driftPerMinute() < 400);
+}
+
+static void testLightPressNotAbsorbed() {
+    // Pie apoyado al 1 % (dentro de la banda de reposo) durante 10 min
+    Feeder f;
+    f.feed(50000, 600);
+    const int32_t before = f.zero.offset();
+    f.feed(51000, 6000);
+    CHECK_NEAR(f.zero.offset(), before, 20); // Solo el ajuste fino al ruido, no las 1000 cuentas
+    f.feed(50000, 100);
+    CHECK_NEAR(f.zero.offset(), before, 20);
+}
+
+static void testPressedBlocksNotTracked() {
+    // Pisando a fondo no se toca el offset
+    Feeder f;
+    f.feed(50000, 100);
+    const int32_t before = f.zero.offset();
+    f.feed(150000, 3000);
+    CHECK_NEAR(f.zero.offset(), before, 20);
+}
+
+static void testDriftAfterBrakingRecovers() {
+    // Deriva acumulada mientras se frenaba (más que sigma): al soltar se recupera
+    Feeder f;
+    f.feed(50000, 100);
+    f.feed(80000, 50);
+    f.feed(51200, 6000);
+    CHECK_NEAR(f.zero.offset(), 51200, SIGMA);
+}
+
+static void testBandChangeAppliedByUpdate() {
+    // setIdleBand() desde el otro núcleo solo se aplica en el siguiente update()
+    Feeder f;
+    f.feed(50000, 100);
+    f.zero.setIdleBand(0, 0); // Sin banda: ya no se sigue la deriva
+    const int32_t before = f.zero.offset();
+    f.feed(50300, 2000);
+    CHECK_EQ(f.zero.offset(), before);
+    f.zero.setIdleBand(BAND, SIGMA);
+    f.feed(50300, 2000);
+    CHECK_NEAR(f.zero.offset(), 50300, SIGMA);
+}
+
+int main() {
+    testInitialTare();
+    testTareRequest();
+    testTracksSlowDrift();
+    testLightPressNotAbsorbed();
+    testPressedBlocksNotTracked();
+    testDriftAfterBrakingRecovers();
+    testBandChangeAppliedByUpdate();
+    return testResult("AutoZero");
+}
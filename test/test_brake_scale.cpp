@@ -0,0 +1,55 @@
+/**
+ * @file test_brake_scale.cpp
+ * @brief Pruebas de BrakeScale: exactitud frente al cálculo en double y recortes.
+ */
+#include "test.h"
+#include "BrakeScale.h"
+
+static constexpr int32_t FULL = 16384; // ADC_brake del sketch
+
+static void testMatchesDoubleReference() {
+    const float forces[] = {1000, 4321, 65536, 250000, 1000000, 3333333, 8388607};
+    uint32_t worst = 0;
+    for (float force : forces) {
+        BrakeScale s;
+        s.configure(force, FULL);
+        for (int32_t i = 0; i <= 4096; i++) {
+            const int32_t raw = (int32_t)((int64_t)force * i / 4096);
+            const int32_t ref = (int32_t)((double)raw * FULL / (int64_t)force);
+            const uint32_t err = (uint32_t)abs(s.apply(raw) - ref);
+            if (err > worst) worst = err;
+        }
+        CHECK(s.apply((int32_t)force) >= FULL - 1); // El tope llega al fondo de escala
+    }
+    CHECK(worst <= 1); // El factor se redondea hacia abajo: como mucho una cuenta por debajo
+}
+
+static void testClamps() {
+    BrakeScale s;
+    s.configure(1000000, FULL);
+    CHECK_EQ(s.apply(-1), 0);
+    CHECK_EQ(s.apply(INT32_MIN), 0);
+    CHECK_EQ(s.apply(2000000), FULL);
+    CHECK_EQ(s.apply(INT32_MAX), FULL);
+    CHECK_EQ(s.apply(0), 0);
+}
+
+static void testSmallForceSaturates() {
+    BrakeScale s;
+    s.configure(100, FULL); // 16384 << 24 / 100 no cabe en int32
+    CHECK_EQ(s.factor(), INT32_MAX);
+    CHECK_EQ(s.apply(1), 127);
+    CHECK_EQ(s.apply(200), FULL);
+
+    s.configure(0, FULL); // Se trata como 1
+    CHECK_EQ(s.factor(), INT32_MAX);
+    s.configure(-5, FULL);
+    CHECK_EQ(s.apply(-5), 0);
+}
+
+int main() {
+    testMatchesDoubleReference();
+    testClamps();
+    testSmallForceSaturates();
+    return testResult("BrakeScale");
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_ema_filter.cpp
+ * @brief Pruebas de EmaFilter: coeficiente exacto, respuesta al escalón frente a las
+ *        versiones en float e independencia del dt.
+ */
+#include "test.h"
+#include "EmaFilter.h"
+
+static void testCoefficientTable() {
+    // 1 - exp(-x) en Q15 frente al valor exacto, dentro y fuera de la tabla
+    int32_t maxErr = 0;
+    for (uint32_t r = 0; r < (8u << 16); r += 97) {
+        const double exact = (1.0 - exp(-(double)r / 65536)) * 32768;
+        maxErr = max(maxErr, abs((int32_t)EmaFilter::coefficient(r) - (int32_t)lround(exact)));
+    }
+    CHECK(maxErr <= 1);
+    CHECK_EQ(EmaFilter::coefficient(0), 0);
+    CHECK_EQ(EmaFilter::coefficient(8u << 16), 1 << 15);
+    CHECK_EQ(EmaFilter::coefficient(1ull << 40), 1 << 15); // dt enorme: sin desbordar
+}
+
+static void testTauForDeciHz() {
+    CHECK_EQ(EmaFilter::tauForDeciHz(0), 0);
+    CHECK_NEAR(EmaFilter::tauForDeciHz(10), 159155, 1);  // 1 Hz
+    CHECK_NEAR(EmaFilter::tauForDeciHz(200), 7958, 1);   // 20 Hz
+}
+
+static void testDisabledPassesThrough() {
+    EmaFilter f;
+    f.setCutoffHz(0);
+    CHECK_EQ(f.update(100, 0), 100);
+    CHECK_EQ(f.update(3000, 1000), 3000);
+}
+
+static void testFirstSampleNoRamp() {
+    EmaFilter f;
+    f.setCutoffHz(5);
+    CHECK_EQ(f.update(2500, 123), 2500);
+    CHECK_EQ(f.value(), 2500);
+}
+
+static void testStepResponseMatchesRc() {
+    // Escalón de 0 a 4000 con fc = 2 Hz a 1 kHz: tras t la salida es 4000 (1 - exp(-t / tau))
+    EmaFilter f;
+    f.setCutoffHz(2);
+    f.reset(0, 0);
+    const double tau = 1.0 / (2 * PI * 2);
+    int32_t maxErr = 0;
+    for (uint32_t t = 1000; t <= 500000; t += 1000) {
+        const int32_t out = f.update(4000, t);
+        const double exact = 4000 * (1 - exp(-(t * 1e-6) / tau));
+        maxErr = max(maxErr, abs(out - (int32_t)lround(exact)));
+    }
+    CHECK(maxErr <= 2);
+}
+
+// filterEMA() en float que EmaFilter sustituyó en el sketch: k = (100 - alpha) / 100 por muestra
+static float legacyEma(float current, float previous, uint8_t alphaPct) {
+    if (alphaPct >= 100) return previous;
+    if (alphaPct == 0) return current;
+    const float k = (100.0f - alphaPct) / 100.0f;
+    return (current * k) + (previous * (1.0f - k));
+}
+
+static void testStepMatchesLegacyFloat() {
+    // Con loop() a 1 kHz, el % antiguo se migra a fc = -ln(alpha) * 1000 / (2 pi) redondeado a
+    // Hz (legacyFilterHz() del sketch). Subida y bajada de 4095 cuentas frente al float antiguo.
+    for (uint8_t alpha : {10, 30, 50, 70, 90, 95}) {
+        const uint16_t hz = (uint16_t)lroundf(-logf(alpha / 100.0f) * 1000.0f / (2.0f * (float)PI));
+        EmaFilter f;
+        f.setCutoffHz(hz);
+        f.reset(0, 0);
+        float legacy = 0;
+        int32_t maxErr = 0;
+        for (uint32_t i = 1; i <= 400; i++) {
+            const int32_t x = i <= 200 ? 4095 : 0;
+            legacy = legacyEma((float)x, legacy, alpha);
+            const int32_t out = f.update(x, i * 1000);
+            maxErr = max(maxErr, abs(out - (int32_t)lroundf(legacy)));
+        }
+        // Lo que queda es el redondeo de fc a Hz enteros: < 1 % del fondo de escala
+        CHECK(maxErr <= 40);
+    }
+}
+
+static void testMatchesFloatWithJitter() {
+    // La misma discretización exacta del RC en float, con dt irregular (0.2-30 ms)
+    EmaFilter f;
+    f.setCutoffHz(8);
+    f.reset(0, 0);
+    const double tau = 1e6 / (2 * PI * 8);
+    double ref = 0;
+    uint32_t t = 0, seed = 1;
+    int32_t maxErr = 0;
+    for (int i = 0; i < 5000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        const uint32_t dt = 200 + (seed >> 8) % 29800;
+        const int32_t x = (i / 300) % 2 ? 16000 : 500;
+        t += dt;
+        ref += (x - ref) * (1 - exp(-(double)dt / tau));
+        maxErr = max(maxErr, abs(f.update(x, t) - (int32_t)lround(ref)));
+    }
+    CHECK(maxErr <= 2);
+}
+
+static void testIndependentOfSampleRate() {
+    // El mismo escalón muestreado a 1 kHz y a 40 Hz llega al mismo valor en el mismo instante
+    EmaFilter fast, slow;
+    fast.setCutoffHz(5);
+    slow.setCutoffHz(5);
+    fast.reset(0, 0);
+    slow.reset(0, 0);
+    for (uint32_t t = 1000; t <= 100000; t += 1000) fast.update(10000, t);
+    for (uint32_t t = 25000; t <= 100000; t += 25000) slow.update(10000, t);
+    CHECK_NEAR(fast.value(), slow.value(), 3);
+
+    // Un hueco largo (loop() parado) no deja el filtro a medias ni desborda
+    slow.update(0, 100000 + 5000000);
+    CHECK_EQ(slow.value(), 0);
+}
+
+static void testConvergesExactly() {
+    // Con estado fraccionario la salida llega a la entrada aunque el paso sea < 1 cuenta
+    EmaFilter f;
+    f.setCutoffHz(1);
+    f.reset(0, 0);
+    uint32_t t = 0;
+    for (int i = 0; i < 20000; i++) f.update(7, t += 1000);
+    CHECK_EQ(f.value(), 7);
+    for (int i = 0; i < 20000; i++) f.update(-3, t += 1000);
+    CHECK_EQ(f.value(), -3);
+}
+
+static void testMicrosWrap() {
+    // El dt se calcula sin signo: el desbordamiento de micros() no produce saltos
+    EmaFilter a, b;
+    a.setCutoffHz(10);
+    b.setCutoffHz(10);
+    const uint32_t start = 0xFFFFFFFFu - 50000;
+    a.reset(0, start);
+    b.reset(0, 0);
+    for (uint32_t k = 1; k <= 100; k++) {
+        a.update(1000, start + k * 1000);
+        b.update(1000, k * 1000);
+    }
+    CHECK_EQ(a.value(), b.value());
+}
+
+int main() {
+    testCoefficientTable();
+    testTauForDeciHz();
+    testDisabledPassesThrough();
+    testFirstSampleNoRamp();
+    testStepResponseMatchesRc();
+    testStepMatchesLegacyFloat();
+    testMatchesFloatWithJitter();
+    testIndependentOfSampleRate();
+    testConvergesExactly();
+    testMicrosWrap();
+    return testResult("EmaFilter");
+}
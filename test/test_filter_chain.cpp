@@ -0,0 +1,116 @@
+/**
+ * @file test_filter_chain.cpp
+ * @brief Pruebas de FilterChain y de sus etapas Deadband y SpikeReject.
+ */
+#include "test.h"
+#include "FilterChain.h"
+#include "EmaFilter.h"
+#include "OneEuroFilter.h"
+#include "Deadband.h"
+
+// Etapas de prueba: suman una constante y registran el orden de llamada
+static char callOrder[8];
+static uint8_t callCount = 0;
+
+template<char Name, int32_t Add>
+struct AddStage {
+    int32_t offset = Add;
+    uint32_t lastUs = 0;
+    inline int32_t update(int32_t x, uint32_t nowUs) {
+        if (callCount < sizeof(callOrder)) callOrder[callCount++] = Name;
+        lastUs = nowUs;
+        return x + offset;
+    }
+};
+
+static void testDeadband() {
+    Deadband d;
+    d.configure(0, 0, 1000);
+    CHECK_EQ(d.update(0, 0), 0);
+    CHECK_EQ(d.update(537, 0), 537); // Sin zonas deja pasar el valor
+
+    d.configure(10, 5, 1000); // 0..100 -> 0 y 950..1000 -> 1000
+    CHECK_EQ(d.update(-5, 0), 0);
+    CHECK_EQ(d.update(100, 0), 0);
+    CHECK_EQ(d.update(950, 0), 1000);
+    CHECK_EQ(d.update(2000, 0), 1000);
+    CHECK_EQ(d.update(525, 0), 500); // Centro de 100..950
+    int32_t prev = 0;
+    bool monotonic = true;
+    for (int32_t x = 0; x <= 1000; x++) {
+        const int32_t y = d.update(x, 0);
+        if (y < prev) monotonic = false;
+        prev = y;
+    }
+    CHECK(monotonic);
+
+    d.configure(90, 90, 65535); // Se limita a MAX_PERCENT por zona
+    CHECK_EQ(d.update(65535 / 4, 0), 0);
+    CHECK_NEAR(d.update(65535 / 2, 0), 65535 / 2, 1);
+}
+
+static void testEmptyChain() {
+    FilterChain<> chain;
+    CHECK_EQ(chain.update(42, 0), 42);
+    bool called = false;
+    chain.with<Deadband>([&](Deadband&) { called = true; });
+    CHECK(!called);
+}
+
+static void testOrderAndTimestamps() {
+    FilterChain<AddStage<'a', 1>, AddStage<'b', 10>, AddStage<'c', 100>> chain;
+    callCount = 0;
+    CHECK_EQ(chain.update(0, 777), 111);
+    CHECK_EQ(callCount, 3);
+    CHECK(callOrder[0] == 'a' && callOrder[1] == 'b' && callOrder[2] == 'c');
+
+    uint32_t seen = 0;
+    chain.with<AddStage<'b', 10>>([&](AddStage<'b', 10>& s) { seen = s.lastUs; });
+    CHECK_EQ(seen, 777); // Todas las etapas reciben la marca de tiempo de la muestra
+}
+
+static void testWithSelectsStage() {
+    // with<Etapa> configura solo esa etapa y no hace nada si no está en la cadena
+    FilterChain<AddStage<'a', 1>, AddStage<'b', 10>> chain;
+    chain.with<AddStage<'b', 10>>([](AddStage<'b', 10>& s) { s.offset = 1000; });
+    CHECK_EQ(chain.update(0, 0), 1001);
+    bool called = false;
+    chain.with<Deadband>([&](Deadband&) { called = true; });
+    CHECK(!called);
+}
+
+static void testPedalChain() {
+    // La composición del sketch: con el EMA y el One Euro desactivados solo actúa la zona muerta
+    FilterChain<EmaFilter, OneEuroFilter, Deadband> chain;
+    chain.with<EmaFilter>([](EmaFilter& f) { f.setCutoffHz(0); });
+    chain.with<OneEuroFilter>([](OneEuroFilter& f) { f.configure(10, 0, 4095); f.setEnabled(false); });
+    chain.with<Deadband>([](Deadband& d) { d.configure(5, 5, 4095); });
+    CHECK_EQ(chain.update(100, 1000), 0);
+    CHECK_EQ(chain.update(4000, 2000), 4095);
+    CHECK_NEAR(chain.update(2048, 3000), 2048, 1);
+
+    // Con el EMA activo la salida se suaviza antes de la zona muerta
+    chain.with<EmaFilter>([](EmaFilter& f) { f.setCutoffHz(1); });
+    chain.update(2048, 4000);
+    CHECK(chain.update(4000, 5000) < 2200);
+}
+
+static void testSpikeReject() {
+    FilterChain<SpikeReject> chain;
+    chain.with<SpikeReject>([](SpikeReject& s) { s.setThreshold(50); });
+    const int32_t in[] = {1000, 1000, 1000, 3000, 1000, 1000};
+    for (int32_t x : in) CHECK_EQ(chain.update(x, 0), 1000);
+    uint32_t spikes = 0;
+    chain.with<SpikeReject>([&](SpikeReject& s) { spikes = s.getCount(); });
+    CHECK_EQ(spikes, 1);
+}
+
+int main() {
+    testDeadband();
+    testEmptyChain();
+    testOrderAndTimestamps();
+    testWithSelectsStage();
+    testPedalChain();
+    testSpikeReject();
+    return testResult("FilterChain");
+}
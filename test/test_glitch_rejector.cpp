@@ -0,0 +1,103 @@
+/**
+ * @file test_glitch_rejector.cpp
+ * @brief Pruebas de GlitchRejector: códigos de saturación, mediana y limitador de slew.
+ */
+#include "test.h"
+#include "GlitchRejector.h"
+
+static constexpr uint32_t PERIOD_US = 12500; // 80 muestras/s
+
+static void testSaturatedCodes() {
+    GlitchRejector g;
+    int32_t out = -1;
+    CHECK(g.isInvalidCode(0x7FFFFF));
+    CHECK(g.isInvalidCode(-0x800000));
+    CHECK(g.isInvalidCode(-1));
+    CHECK(!g.isInvalidCode(0));
+    CHECK(!g.process(0x7FFFFF, 123, 0, out));
+    CHECK(!g.process(-1, 123, 0, out));
+    CHECK_EQ(out, -1);
+    CHECK_EQ(g.counters().saturated, 2);
+    CHECK(g.process(1000, 1000, 0, out));
+    CHECK_EQ(out, 1000);
+    CHECK_EQ(g.counters().accepted, 1);
+}
+
+static void testMedianRemovesSpike() {
+    GlitchRejector g; // Sin límite de slew: solo la mediana
+    int32_t out = 0;
+    const int32_t in[] = {100, 100, 100, 5000, 100, 100};
+    for (int32_t x : in) {
+        CHECK(g.process(x, x, 0, out));
+        CHECK_EQ(out, 100);
+    }
+}
+
+static void testSlewLimitPerSecond() {
+    // 1000 cuentas/s a 80 muestras/s: 12 cuentas por muestra como mucho
+    GlitchRejector g;
+    g.setMaxRate(1000);
+    int32_t out = 0;
+    uint32_t t = 0;
+    for (int i = 0; i < 3; i++, t += PERIOD_US) CHECK(g.process(0, 0, t, out));
+
+    // Una rampa dentro del límite pasa entera (con la muestra de retardo de la mediana)
+    int32_t x = 0;
+    for (int i = 0; i < 20; i++, t += PERIOD_US) {
+        x += 12;
+        CHECK(g.process(x, x, t, out));
+    }
+    CHECK_EQ(out, x - 12);
+    CHECK_EQ(g.counters().slew, 0);
+
+    // El límite escala con el dt real: tras 1 s sin muestras se permiten 1000 cuentas
+    t += 1000000;
+    g.reset();
+    CHECK(g.process(x, x, t, out));
+    CHECK(g.process(x + 1000, x + 1000, t + 1000000, out));
+}
+
+static void testRealStepResyncs() {
+    // Un pisotón real (escalón mantenido) sale con como mucho una muestra de retardo
+    // además de la de la mediana; un pico aislado no sale nunca
+    GlitchRejector g;
+    g.setMaxRate(1000);
+    int32_t out = 0;
+    uint32_t t = 0;
+    for (int i = 0; i < 3; i++, t += PERIOD_US) g.process(0, 0, t, out);
+
+    int delivered = -1;
+    for (int i = 0; i < 5; i++, t += PERIOD_US) {
+        if (g.process(50000, 50000, t, out) && out == 50000 && delivered < 0) delivered = i;
+    }
+    CHECK(delivered >= 0 && delivered <= 2);
+    CHECK(g.counters().slew >= 1);
+
+    // Tras el escalón el valor sigue fijo y no se cuentan más rechazos
+    const uint32_t slew = g.counters().slew;
+    for (int i = 0; i < 5; i++, t += PERIOD_US) {
+        CHECK(g.process(50000, 50000, t, out));
+        CHECK_EQ(out, 50000);
+    }
+    CHECK_EQ(g.counters().slew, slew);
+}
+
+static void testResetCounters() {
+    GlitchRejector g;
+    int32_t out;
+    g.process(0x7FFFFF, 0, 0, out);
+    g.process(1, 1, 0, out);
+    g.resetCounters();
+    CHECK_EQ(g.counters().accepted, 0);
+    CHECK_EQ(g.counters().saturated, 0);
+    CHECK_EQ(g.counters().slew, 0);
+}
+
+int main() {
+    testSaturatedCodes();
+    testMedianRemovesSpike();
+    testSlewLimitPerSecond();
+    testRealStepResyncs();
+    testResetCounters();
+    return testResult("GlitchRejector");
+}
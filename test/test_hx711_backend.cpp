@@ -0,0 +1,119 @@
+/**
+ * @file test_hx711_backend.cpp
+ * @brief Pruebas de HX711 sobre un HX711Backend simulado: pulsos de ganancia,
+ *        extensión de signo de 24 bits y espera a DOUT bajo.
+ */
+#include "test.h"
+#include "hx711_mock.h"
+
+static void testBeginPassesPins() {
+    MockHX711Backend backend;
+    HX711 adc(12, 13);
+    adc.set_backend(&backend);
+    CHECK(adc.begin());
+    CHECK_EQ(backend.dout, 12);
+    CHECK_EQ(backend.sck, 13);
+    CHECK_EQ(adc.ready_pin(), 12);
+}
+
+static void testGainPulses() {
+    MockHX711Backend backend;
+    HX711 adc;
+    adc.set_backend(&backend);
+
+    // 25 pulsos = canal A x128, 27 = canal A x64, 26 = canal B x32
+    adc.begin(2, 3);
+    backend.push(0); adc.read();
+    adc.begin(2, 3, 64);
+    backend.push(0); adc.read();
+    adc.set_gain(32);
+    backend.push(0); adc.read();
+    adc.set_gain(128);
+    backend.push(0); adc.read();
+    adc.set_gain(100); // Ganancia no válida: se mantiene la anterior
+    backend.push(0); adc.read();
+
+    const byte expected[] = {1, 3, 2, 1, 1};
+    CHECK_EQ(backend.gainPulses.size(), 5);
+    for (size_t i = 0; i < backend.gainPulses.size() && i < 5; i++) CHECK_EQ(backend.gainPulses[i], expected[i]);
+}
+
+static void testSignExtension() {
+    MockHX711Backend backend;
+    HX711 adc(2, 3);
+    adc.set_backend(&backend);
+    adc.begin();
+
+    const uint32_t words[] = {0x000000, 0x000001, 0x7FFFFF, 0x800000, 0x800001, 0xFFFFFF, 0x123456, 0xEDCBAA};
+    const long expected[] = {0, 1, 8388607, -8388608, -8388607, -1, 0x123456, -0x123456};
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        backend.push(words[i]);
+        CHECK_EQ(adc.read(), expected[i]);
+    }
+
+    // Bits por encima del 24 que devuelva un backend se ignoran
+    backend.push(0xAB000010);
+    CHECK_EQ(adc.read(), 0x10);
+    backend.push(0x01FFFFFF);
+    CHECK_EQ(adc.read(), -1);
+}
+
+static void testReadWaitsForReady() {
+    MockHX711Backend backend;
+    backend.busyPolls = 5;
+    HX711 adc(2, 3);
+    adc.set_backend(&backend);
+    adc.begin();
+
+    CHECK(!adc.is_ready()); // Nada convertido: DOUT alto
+    backend.push(42);
+    backend.push(43);
+    const int before = backend.polls;
+    CHECK_EQ(adc.read(), 42);
+    CHECK_EQ(backend.polls - before, 6); // 5 "no listo" y el que lo libera
+    CHECK_EQ(adc.read(), 43);
+    CHECK_EQ(backend.readsWhileBusy, 0); // Nunca se pulsa PD_SCK con DOUT alto
+}
+
+static void testWaitReadyVariants() {
+    MockHX711Backend backend;
+    HX711 adc(2, 3);
+    adc.set_backend(&backend);
+    adc.begin();
+
+    CHECK(!adc.wait_ready_retry(3));
+    CHECK(!adc.wait_ready_timeout(5));
+
+    backend.busyPolls = 2;
+    backend.push(1);
+    CHECK(!adc.wait_ready_retry(2));
+    CHECK(adc.wait_ready_retry(2));
+    CHECK(adc.wait_ready_timeout(5));
+    CHECK_EQ(backend.readsWhileBusy, 0); // Esperar no lee
+}
+
+static void testPowerDownUp() {
+    MockHX711Backend backend;
+    HX711 adc(2, 3);
+    adc.set_backend(&backend);
+    adc.begin();
+    adc.power_down();
+    adc.power_up();
+    // power_down(): flanco de subida y PD_SCK alto; power_up(): vuelve a bajo
+    CHECK_EQ(backend.clockLevels.size(), 3);
+    if (backend.clockLevels.size() == 3) {
+        CHECK(!backend.clockLevels[0]);
+        CHECK(backend.clockLevels[1]);
+        CHECK(!backend.clockLevels[2]);
+    }
+}
+
+int main() {
+    testBeginPassesPins();
+    testGainPulses();
+    testSignExtension();
+    testReadWaitsForReady();
+    testWaitReadyVariants();
+    testPowerDownUp();
+    return testResult("HX711Backend");
+}
@@ -0,0 +1,79 @@
+/**
+ * @file test_hx711_fast.cpp
+ * @brief Pruebas de HX711FastBackend contra un HX711 simulado detrás de los registros GPIO.
+ */
+#include "test.h"
+#include "hx711_mock.h"
+#include "HX711Fast.h"
+
+static const uint32_t WORDS[] = {0x000000, 0x000001, 0x7FFFFF, 0x800000, 0xFFFFFF, 0x123456, 0xA5A5A5};
+static constexpr uint32_t HOLD = (uint32_t)((uint64_t)F_CPU * HX711_FAST_HALF_PERIOD_NS / 1000000000ULL);
+
+template<uint8_t DOUT, uint8_t SCK>
+static void checkBackend() {
+    SimulatedHX711 chip(DOUT, SCK);
+    HX711FastBackend<DOUT, SCK> fast;
+    fast.begin(0, 0);
+    for (byte gain = 1; gain <= 3; gain++) {
+        for (uint32_t w : WORDS) {
+            chip.convert(w);
+            CHECK(fast.is_ready());
+            CHECK_EQ(fast.read_raw(gain), w);
+            CHECK_EQ(chip.pulses, 24 + gain);
+            CHECK(!chip.sck);             // PD_SCK queda bajo: el chip no se apaga
+            CHECK(!fast.is_ready());       // DOUT alto hasta la siguiente conversión
+            CHECK(chip.minHigh >= HOLD);   // >= 200 ns en alto y en bajo según la hoja de datos
+            CHECK(chip.minLow >= HOLD);
+        }
+    }
+    fast.set_clock(true);
+    CHECK(chip.sck);
+    fast.set_clock(false);
+    CHECK(!chip.sck);
+}
+
+static void testBothBanks() {
+    checkBackend<4, 5>();   // GPIO_IN / GPIO_OUT
+    checkBackend<40, 41>(); // GPIO_IN1 / GPIO_OUT1
+    checkBackend<4, 40>();
+    checkBackend<39, 2>();
+}
+
+static void testMatchesGpioBackend() {
+    SimulatedHX711 chip(4, 5);
+    HX711FastBackend<4, 5> fast;
+    HX711GpioBackend gpio;
+    fast.begin(4, 5);
+    gpio.begin(4, 5);
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < 2000; i++) {
+        const uint32_t w = (i * 2654435761u) >> 8;
+        const byte gain = 1 + i % 3;
+        chip.convert(w);
+        const uint32_t a = fast.read_raw(gain);
+        const int pulsesFast = chip.pulses;
+        chip.convert(w);
+        const uint32_t b = gpio.read_raw(gain);
+        if (a != b || pulsesFast != chip.pulses) mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+static void testDriverReadsThroughRegisters() {
+    SimulatedHX711 chip(6, 7);
+    static HX711Fast<6, 7> adc(64);
+    adc.begin();
+    const long expected[] = {0, 1, 8388607, -8388608, -1, 0x123456, -0x5A5A5B};
+    for (size_t i = 0; i < sizeof(WORDS) / sizeof(WORDS[0]); i++) {
+        chip.convert(WORDS[i]);
+        CHECK_EQ(adc.read(), expected[i]);
+        CHECK_EQ(chip.pulses, 27); // Ganancia 64: tres pulsos extra
+    }
+}
+
+int main() {
+    testBothBanks();
+    testMatchesGpioBackend();
+    testDriverReadsThroughRegisters();
+    return testResult("HX711Fast");
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_hx711_multi.cpp
+ * @brief Pruebas de HX711Multi: montaje MSB primero y extensión de signo por canal.
+ */
+#include "test.h"
+#include "HX711Multi.h"
+
+static const uint32_t WORDS[] = {0x000000, 0x000001, 0x7FFFFF, 0x800000, 0xFFFFFF, 0x123456, 0xA5A5A5, 0x5A5A5A};
+static constexpr byte NWORDS = sizeof(WORDS) / sizeof(WORDS[0]);
+
+static long expectedValue(uint32_t w) { return (w & 0x800000) ? (long)w - 0x1000000 : (long)w; }
+
+// Mapa de niveles del pulso `bit` (0 = MSB) con DOUT[i] mostrando words[i]
+static uint64_t inputsFor(const byte* dout, const uint32_t* words, byte count, byte bit) {
+    uint64_t inputs = 0;
+    for (byte i = 0; i < count; i++) {
+        if ((words[i] >> (23 - bit)) & 1) inputs |= (uint64_t)1 << dout[i];
+    }
+    return inputs;
+}
+
+static void checkChannels(const byte* dout, byte count) {
+    uint32_t words[HX711_MULTI_MAX];
+    for (byte rot = 0; rot < NWORDS; rot++) {
+        for (byte i = 0; i < count; i++) words[i] = WORDS[(rot + i * 3) % NWORDS];
+
+        uint32_t acc[HX711_MULTI_MAX] = {0};
+        for (byte bit = 0; bit < 24; bit++) {
+            HX711Multi::shift_in_bit(inputsFor(dout, words, count, bit), dout, count, acc);
+        }
+        for (byte i = 0; i < count; i++) {
+            CHECK_EQ(acc[i], words[i]);
+            CHECK_EQ(HX711Multi::sign_extend(acc[i]), expectedValue(words[i]));
+        }
+    }
+}
+
+static void testOneChannel() {
+    const byte dout[] = {4};
+    checkChannels(dout, 1);
+}
+
+static void testTwoChannels() {
+    const byte dout[] = {4, 5};
+    checkChannels(dout, 2);
+    const byte banks[] = {31, 32}; // Uno en cada banco de GPIO
+    checkChannels(banks, 2);
+}
+
+static void testFourChannels() {
+    const byte dout[] = {0, 17, 40, 48};
+    checkChannels(dout, 4);
+}
+
+static void testOtherPinsIgnored() {
+    // Niveles en pines ajenos (p.ej. PD_SCK alto durante el muestreo) no entran en el canal
+    const byte dout[] = {6};
+    uint32_t acc[1] = {0};
+    for (byte bit = 0; bit < 24; bit++) HX711Multi::shift_in_bit(~((uint64_t)1 << 6), dout, 1, acc);
+    CHECK_EQ(acc[0], 0);
+}
+
+static void testSignExtendMasksHighBits() {
+    CHECK_EQ(HX711Multi::sign_extend(0xFF000001), 1);
+    CHECK_EQ(HX711Multi::sign_extend(0x01800000), -8388608);
+    CHECK_EQ(HX711Multi::sign_extend(0x007FFFFF), 8388607);
+}
+
+// Varios HX711 en el mismo PD_SCK: cada flanco de subida saca el siguiente bit de todos
+static constexpr byte SCK = 9;
+static const byte SIM_DOUT[] = {4, 5, 6, 7};
+static uint32_t simWords[4];
+static int simPulses = 0;
+static bool simSck = false;
+
+static int simRead(uint8_t pin) {
+    for (byte i = 0; i < 4; i++) {
+        if (pin != SIM_DOUT[i]) continue;
+        if (simPulses == 0) return LOW;
+        if (simPulses > 24) return HIGH;
+        return (simWords[i] >> (24 - simPulses)) & 1;
+    }
+    return LOW;
+}
+static void simWrite(uint8_t pin, uint8_t val) {
+    if (pin != SCK) return;
+    if (val == HIGH && !simSck) simPulses++;
+    simSck = val == HIGH;
+}
+
+static void testSharedClockRead() {
+    hostDigitalRead = simRead;
+    hostDigitalWrite = simWrite;
+    for (byte count : {1, 2, 4}) {
+        HX711Multi multi(count, SIM_DOUT, SCK, 64);
+        multi.begin();
+        for (byte rot = 0; rot < NWORDS; rot++) {
+            for (byte i = 0; i < 4; i++) simWords[i] = WORDS[(rot + i) % NWORDS];
+            simPulses = 0;
+            long values[4] = {0};
+            CHECK(multi.read(values, 10));
+            CHECK_EQ(simPulses, 27); // 24 bits + 3 de ganancia x64
+            CHECK(!simSck);
+            for (byte i = 0; i < count; i++) CHECK_EQ(values[i], expectedValue(simWords[i]));
+        }
+    }
+    hostDigitalRead = nullptr;
+    hostDigitalWrite = nullptr;
+}
+
+int main() {
+    testOneChannel();
+    testTwoChannels();
+    testFourChannels();
+    testOtherPinsIgnored();
+    testSignExtendMasksHighBits();
+    testSharedClockRead();
+    return testResult("HX711Multi");
+}
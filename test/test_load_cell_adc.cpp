@@ -0,0 +1,83 @@
+/**
+ * @file test_load_cell_adc.cpp
+ * @brief Pruebas de los servicios comunes de LoadCellADC (tara, escala, ventana) sobre HX711.
+ */
+#include "test.h"
+#include "hx711_mock.h"
+
+struct Cell {
+    MockHX711Backend backend;
+    HX711 adc{4, 5};
+
+    Cell() {
+        adc.set_backend(&backend);
+        adc.begin();
+    }
+    LoadCellADC& cell() { return adc; }
+    void push(long value) { backend.push((uint32_t)value & 0xFFFFFF); }
+};
+
+static void testReadAverageAndTare() {
+    Cell c;
+    for (long v : {1000, 1010, 990, 1000}) c.push(v);
+    CHECK_EQ(c.cell().read_average(4), 1000);
+
+    for (long v : {-200, -196, -204}) c.push(v);
+    c.cell().tare(3);
+    CHECK_EQ(c.cell().get_offset(), -200);
+
+    c.push(300);
+    CHECK_EQ(c.cell().read_tared(), 500);
+}
+
+static void testScale() {
+    Cell c;
+    c.cell().set_offset(100);
+    c.cell().set_scale(2.5f);
+    c.push(1100);
+    CHECK_NEAR(c.cell().get_units(1), 400, 0);
+    c.push(-900);
+    CHECK_NEAR(c.cell().get_value(1), -1000, 0);
+}
+
+static void testWindow() {
+    Cell c;
+    LoadCellADC& cell = c.cell();
+    cell.set_window(4);
+    CHECK(!cell.tare_window());
+    for (long v : {10, 20, 30}) { c.push(v); cell.read(); }
+    CHECK_EQ(cell.window_count(), 3);
+    CHECK(!cell.window_full());
+    CHECK_EQ(cell.read_window_average(), 20);
+
+    // Llena: la más antigua sale de la suma
+    for (long v : {40, 50}) { c.push(v); cell.read(); }
+    CHECK(cell.window_full());
+    CHECK_EQ(cell.read_window_average(), 35);
+    CHECK(cell.tare_window());
+    CHECK_EQ(cell.get_offset(), 35);
+    CHECK_NEAR(cell.get_value_window(), 0, 0);
+
+    cell.reset_window();
+    CHECK_EQ(cell.window_count(), 0);
+    CHECK_EQ(cell.read_window_average(), 0);
+}
+
+static void testWindowSizeIsClamped() {
+    Cell c;
+    LoadCellADC& cell = c.cell();
+    cell.set_window(0);
+    c.push(7); cell.read();
+    CHECK(cell.window_full());
+    cell.set_window(200);
+    for (int i = 0; i < LOADCELL_WINDOW_MAX + 5; i++) { c.push(i); cell.read(); }
+    CHECK_EQ(cell.window_count(), LOADCELL_WINDOW_MAX);
+}
+
+int main() {
+    testReadAverageAndTare();
+    testScale();
+    testWindow();
+    testWindowSizeIsClamped();
+    return testResult("LoadCellADC");
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_nau7802.cpp
+ * @brief Pruebas de NAU7802 sobre un bus de registros simulado, vistas a través de LoadCellADC.
+ */
+#include "test.h"
+#include "NAU7802.h"
+#include <deque>
+
+// Registros que toca el driver (ver NAU7802.cpp)
+static constexpr byte PU_CTRL = 0x00, CTRL1 = 0x01, CTRL2 = 0x02, ADCO_B2 = 0x12;
+static constexpr byte PUD = 1 << 1, PUA = 1 << 2, PUR = 1 << 3, CS = 1 << 4, CR = 1 << 5, AVDDS = 1 << 7;
+static constexpr byte CALS = 1 << 2, CAL_ERR = 1 << 3;
+
+/**
+ * Mapa de registros del chip. La cola de conversiones hace de ADC: PU_CTRL.CR está
+ * activo mientras queda alguna y leer ADCO_B2 consume la primera. Cada conversión
+ * puede marcarse para que su transferencia I2C falle.
+ */
+class MockBus : public NAU7802Bus {
+public:
+    struct Conversion { uint32_t code; bool fails; };
+
+    byte regs[32] = {};
+    std::deque<Conversion> conversions;
+    bool present = true;       ///< false: nadie responde en la dirección
+    bool registersFail = false; ///< Fallan todas las lecturas de registro
+    bool calibrationError = false;
+    int adcReads = 0;
+
+    bool begin() override { return present; }
+
+    bool write_reg(byte reg, byte value) override {
+        if (!present) return false;
+        if (reg == PU_CTRL) {
+            if (value & 1) { memset(regs, 0, sizeof(regs)); return true; }
+            if (value & PUD) value |= PUR;
+        }
+        if (reg == CTRL2 && (value & CALS)) {
+            // La calibración termina al instante
+            value &= ~CALS;
+            value = calibrationError ? (value | CAL_ERR) : (value & ~CAL_ERR);
+        }
+        regs[reg & 31] = value;
+        return true;
+    }
+
+    bool read_regs(byte reg, byte* buf, byte len) override {
+        if (!present || registersFail) return false;
+        if (reg == ADCO_B2) {
+            adcReads++;
+            if (conversions.empty()) return false;
+            const Conversion c = conversions.front();
+            conversions.pop_front();
+            if (c.fails) return false;
+            buf[0] = c.code >> 16; buf[1] = c.code >> 8; buf[2] = c.code;
+            return true;
+        }
+        for (byte i = 0; i < len; i++) buf[i] = regs[(reg + i) & 31];
+        if (reg == PU_CTRL) buf[0] = conversions.empty() ? (buf[0] & ~CR) : (buf[0] | CR);
+        return true;
+    }
+
+    void convert(uint32_t code, bool fails = false) { conversions.push_back({code, fails}); }
+};
+
+static void testBeginConfiguresChip() {
+    MockBus bus;
+    NAU7802 adc(bus, NAU7802::SPS_80, -1, 64);
+    CHECK(adc.begin());
+    CHECK_EQ(bus.regs[PU_CTRL] & (PUD | PUA | CS | AVDDS), PUD | PUA | CS | AVDDS);
+    CHECK_EQ(bus.regs[CTRL1] & 0x07, 6);          // log2(64)
+    CHECK_EQ(bus.regs[CTRL1] & 0x38, 4 << 3);     // LDO a 3.3 V
+    CHECK_EQ((bus.regs[CTRL2] & 0x70) >> 4, NAU7802::SPS_80);
+    CHECK_EQ(adc.sample_rate(), 80);
+    CHECK_EQ(adc.ready_pin(), -1);
+}
+
+static void testBeginReportsFailures() {
+    MockBus absent;
+    absent.present = false;
+    NAU7802 a(absent);
+    CHECK(!a.begin());
+
+    MockBus badCal;
+    badCal.calibrationError = true;
+    NAU7802 b(badCal);
+    CHECK(!b.begin());
+
+    // Sin lecturas de registro nunca se ve PUR: begin() se rinde a los 100 ms
+    MockBus mute;
+    mute.registersFail = true;
+    NAU7802 c(mute);
+    CHECK(!c.begin());
+}
+
+static void testSignExtension() {
+    MockBus bus;
+    NAU7802 adc(bus);
+    adc.begin();
+    const uint32_t codes[] = {0x000000, 0x000001, 0x7FFFFF, 0x800000, 0xFFFFFF, 0x123456, 0xEDCBAA};
+    const long expected[] = {0, 1, 8388607, -8388608, -1, 0x123456, -0x123456};
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++) {
+        bus.convert(codes[i]);
+        CHECK_EQ(adc.read(), expected[i]);
+    }
+    CHECK_EQ(adc.window_count(), 7);
+}
+
+static void testIsReadyFollowsCycleReady() {
+    MockBus bus;
+    NAU7802 adc(bus);
+    adc.begin();
+    CHECK(!adc.is_ready());
+    bus.convert(100);
+    CHECK(adc.is_ready());
+    bus.registersFail = true; // Un fallo de bus cuenta como "no listo"
+    CHECK(!adc.is_ready());
+}
+
+static void testFailedTransferIsDropped() {
+    MockBus bus;
+    NAU7802 adc(bus);
+    adc.begin();
+    adc.set_window(4);
+    bus.convert(1000);
+    bus.convert(5000, true);
+    bus.convert(1002);
+    CHECK_EQ(adc.read(), 1000);
+    CHECK_EQ(adc.read(), LoadCellADC::READ_FAILED);
+    CHECK_EQ(adc.read(), 1002);
+    CHECK_EQ(adc.window_count(), 2);   // La lectura fallida no entra en la ventana
+    CHECK_EQ(adc.read_window_average(), 1001);
+}
+
+static void testReadTimesOut() {
+    MockBus bus;
+    NAU7802 adc(bus, NAU7802::SPS_320);
+    adc.begin();
+    const int readsBefore = bus.adcReads;
+    const unsigned long start = micros();
+    CHECK_EQ(adc.read(), LoadCellADC::READ_FAILED);
+    const unsigned long elapsed = micros() - start;
+    CHECK(elapsed >= 2000000UL / 320);  // Dos periodos de conversión...
+    CHECK(elapsed < 100000);            // ...y no una espera indefinida
+    CHECK_EQ(bus.adcReads, readsBefore); // Sin dato listo no se toca ADCO
+}
+
+static void testLoadCellHelpersSkipFailures() {
+    MockBus bus;
+    NAU7802 adc(bus);
+    adc.begin();
+    LoadCellADC& cell = adc;
+
+    bus.convert(100);
+    bus.convert(0, true);
+    bus.convert(300);
+    CHECK_EQ(cell.read_average(3), 200);
+
+    bus.convert(500);
+    cell.tare(1);
+    CHECK_EQ(cell.get_offset(), 500);
+
+    // Ninguna lectura válida: la tara no cambia y read_tared() propaga el fallo
+    bus.convert(0, true);
+    bus.convert(0, true);
+    cell.tare(2);
+    CHECK_EQ(cell.get_offset(), 500);
+    bus.convert(0, true);
+    CHECK_EQ(cell.read_tared(), LoadCellADC::READ_FAILED);
+    bus.convert(800);
+    CHECK_EQ(cell.read_tared(), 300);
+}
+
+int main() {
+    testBeginConfiguresChip();
+    testBeginReportsFailures();
+    testSignExtension();
+    testIsReadyFollowsCycleReady();
+    testFailedTransferIsDropped();
+    testReadTimesOut();
+    testLoadCellHelpersSkipFailures();
+    return testResult("NAU7802");
+}
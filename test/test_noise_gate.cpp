@@ -0,0 +1,86 @@
+/**
+ * @file test_noise_gate.cpp
+ * @brief Pruebas de NoiseGate: estimación del ruido, umbral y extremos del recorrido.
+ */
+#include "test.h"
+#include "NoiseGate.h"
+
+// Ruido uniforme determinista en +-amp (sigma = amp / sqrt(3))
+static int32_t noise(uint32_t i, int32_t amp) {
+    return (int32_t)((i * 2654435761u) >> 16) % (2 * amp + 1) - amp;
+}
+
+static void testFirstValuePublished() {
+    NoiseGate g;
+    g.begin(2, 4095);
+    int32_t held = -1;
+    CHECK(g.update(1234, held));
+    CHECK_EQ(held, 1234);
+}
+
+static void testCleanSignalRespondsFromMinimum() {
+    // Sin ruido el umbral se queda en el mínimo: 3 cuentas de cambio ya se publican
+    NoiseGate g;
+    g.begin(2, 4095);
+    int32_t held = 0;
+    for (int i = 0; i < 200; i++) g.update(2000, held);
+    CHECK_EQ(g.noise(), 0);
+    CHECK_EQ(g.threshold(), 2);
+    CHECK(!g.update(2002, held));
+    CHECK(g.update(2003, held));
+    CHECK_EQ(held, 2003);
+}
+
+static void testNoiseRaisesThreshold() {
+    // Ruido de +-30 cuentas (sigma ~17): el umbral sube y el pedal quieto no publica
+    NoiseGate g;
+    g.begin(2, 4095);
+    int32_t held = 0;
+    for (uint32_t i = 0; i < 500; i++) g.update(2000 + noise(i, 30), held);
+    CHECK(g.noise() > 8 && g.noise() < 35);
+    CHECK(g.threshold() >= 2 * g.noise());
+
+    int changes = 0;
+    for (uint32_t i = 500; i < 1500; i++) changes += g.update(2000 + noise(i, 30), held);
+    CHECK(changes < 50); // Frente a ~1000 sin histéresis
+
+    // Un movimiento real mayor que el umbral pasa de inmediato
+    CHECK(g.update(2000 + 4 * g.threshold(), held));
+}
+
+static void testRampDoesNotRaiseNoise() {
+    // Rampa a velocidad constante: la segunda diferencia es nula y el umbral no sube
+    NoiseGate g;
+    g.begin(2, 40950);
+    int32_t held = 0;
+    int changes = 0;
+    for (int32_t x = 0; x <= 40000; x += 25) changes += g.update(x, held);
+    CHECK_EQ(g.noise(), 0);
+    CHECK(changes > 1000); // Cada paso de 25 supera el umbral mínimo
+}
+
+static void testEndsAlwaysPublished() {
+    // En 0 y en el fondo de escala se publica aunque el salto sea menor que el umbral
+    NoiseGate g;
+    g.begin(50, 4095);
+    int32_t held = 0;
+    g.update(30, held);
+    g.update(20, held);
+    CHECK(!g.update(10, held));
+    CHECK(g.update(0, held));
+    CHECK_EQ(held, 0);
+    CHECK(!g.update(0, held)); // Ya publicado: sin repeticiones
+
+    g.update(4080, held);
+    CHECK(g.update(4095, held));
+    CHECK_EQ(held, 4095);
+}
+
+int main() {
+    testFirstValuePublished();
+    testCleanSignalRespondsFromMinimum();
+    testNoiseRaisesThreshold();
+    testRampDoesNotRaiseNoise();
+    testEndsAlwaysPublished();
+    return testResult("NoiseGate");
+}
@@ -0,0 +1,86 @@
+/**
+ * @file test_one_euro_filter.cpp
+ * @brief Pruebas de OneEuroFilter: corte en reposo, corte adaptativo y desactivación.
+ */
+#include "test.h"
+#include "OneEuroFilter.h"
+
+static constexpr int32_t SCALE = 4095;
+static constexpr uint32_t PERIOD_US = 1000;
+
+static int32_t noise(uint32_t i) { return (int32_t)((i * 2654435761u) >> 20) % 21 - 10; }
+
+static void testRestUsesMinCutoff() {
+    // En reposo con ruido el corte se queda cerca de minCutoff y la salida es estable
+    OneEuroFilter f;
+    f.configure(10, 2000, SCALE); // 1 Hz, beta 2 Hz por recorrido/s
+    uint32_t t = 0;
+    for (uint32_t i = 0; i < 3000; i++) f.update(2000 + noise(i), t += PERIOD_US);
+    CHECK(f.currentCutoff() < 20);
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    for (uint32_t i = 3000; i < 4000; i++) {
+        const int32_t out = f.update(2000 + noise(i), t += PERIOD_US);
+        lo = min(lo, out);
+        hi = max(hi, out);
+    }
+    CHECK(hi - lo <= 3); // El ruido de entrada es de +-10
+}
+
+static void testFastMoveRaisesCutoff() {
+    // Pisotón de todo el recorrido en 50 ms: el corte sube y el retardo es pequeño
+    OneEuroFilter euro;
+    EmaFilter fixed;
+    euro.configure(10, 2000, SCALE);
+    fixed.setCutoffHz(1);
+    uint32_t t = 0;
+    euro.reset(0, t);
+    fixed.reset(0, t);
+    for (uint32_t i = 1; i <= 50; i++) {
+        t += PERIOD_US;
+        const int32_t x = SCALE * (int32_t)i / 50;
+        euro.update(x, t);
+        fixed.update(x, t);
+    }
+    CHECK(euro.currentCutoff() > 100);         // > 10 Hz durante el movimiento
+    CHECK(euro.value() > SCALE / 2);           // Sigue al pedal
+    CHECK(fixed.value() < SCALE / 5);          // El EMA de 1 Hz va muy por detrás
+    for (uint32_t i = 0; i < 2000; i++) euro.update(SCALE, t += PERIOD_US);
+    CHECK_EQ(euro.value(), SCALE);
+    CHECK(euro.currentCutoff() < 20);          // De vuelta al reposo
+}
+
+static void testCutoffCeiling() {
+    OneEuroFilter f;
+    f.configure(10, 65535, 1);
+    uint32_t t = 0;
+    f.reset(0, t);
+    for (int i = 0; i < 10; i++) f.update(i & 1 ? 1 : 0, t += 100);
+    CHECK(f.currentCutoff() <= OneEuroFilter::MAX_CUTOFF_DECIHZ);
+}
+
+static void testDisabledPassesThrough() {
+    OneEuroFilter f;
+    f.configure(10, 0, SCALE);
+    f.setEnabled(false);
+    CHECK_EQ(f.update(100, 1000), 100);
+    CHECK_EQ(f.update(3000, 2000), 3000);
+    // Al reactivarlo arranca desde el último valor, sin rampa
+    f.setEnabled(true);
+    CHECK_EQ(f.update(3000, 3000), 3000);
+}
+
+static void testSameTimestamp() {
+    OneEuroFilter f;
+    f.configure(10, 2000, SCALE);
+    f.reset(500, 1000);
+    CHECK_EQ(f.update(4000, 1000), 500); // dt = 0: sin velocidad, sin cambio
+}
+
+int main() {
+    testRestUsesMinCutoff();
+    testFastMoveRaisesCutoff();
+    testCutoffCeiling();
+    testDisabledPassesThrough();
+    testSameTimestamp();
+    return testResult("OneEuroFilter");
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_response_curve.cpp
+ * @brief Pruebas de ResponseCurve: validación, identidad, tramos y extremos.
+ */
+#include "test.h"
+#include "ResponseCurve.h"
+
+static CurvePoints points(std::initializer_list<uint8_t> x, std::initializer_list<uint8_t> y) {
+    CurvePoints p = {};
+    p.count = (uint8_t)x.size();
+    uint8_t i = 0;
+    for (uint8_t v : x) p.x[i++] = v;
+    i = 0;
+    for (uint8_t v : y) p.y[i++] = v;
+    return p;
+}
+
+static void testValidation() {
+    CurvePoints p;
+    ResponseCurve::setLinear(p);
+    CHECK(ResponseCurve::isValid(p));
+    CHECK(!ResponseCurve::isValid(points({0}, {0})));                  // Un solo punto
+    CHECK(!ResponseCurve::isValid(points({0, 50, 50}, {0, 10, 100}))); // x no creciente
+    CHECK(!ResponseCurve::isValid(points({0, 101}, {0, 100})));        // Fuera de 0..100
+    CHECK(!ResponseCurve::isValid(points({0, 100}, {0, 120})));
+    CurvePoints many = points({0, 100}, {0, 100});
+    many.count = CurvePoints::MAX_POINTS + 1;
+    CHECK(!ResponseCurve::isValid(many));
+}
+
+static void testLinearIsIdentity() {
+    ResponseCurve c;
+    CurvePoints p;
+    ResponseCurve::setLinear(p);
+    CHECK(c.compile(p, 4095));
+    CHECK(c.isLinear());
+    for (int32_t v = 0; v <= 4095; v += 7) CHECK_EQ(c.apply(v), v);
+}
+
+static void testInvalidFallsBackToLinear() {
+    ResponseCurve c;
+    CHECK(!c.compile(points({50, 10}, {0, 100}), 1000));
+    CHECK(c.isLinear());
+    CHECK_EQ(c.apply(321), 321);
+}
+
+static void testPiecewise() {
+    // Curva en S; se compara con la interpolación exacta en coma flotante
+    const CurvePoints p = points({0, 25, 50, 75, 100}, {0, 12, 50, 88, 100});
+    const int32_t scale = 65535;
+    ResponseCurve c;
+    CHECK(c.compile(p, scale));
+    CHECK(!c.isLinear());
+    int32_t maxErr = 0;
+    bool monotonic = true;
+    int32_t prev = -1;
+    for (int32_t v = 0; v <= scale; v += 13) {
+        const double pct = 100.0 * v / scale;
+        uint8_t s = 0;
+        while (s + 2 < p.count && pct > p.x[s + 1]) s++;
+        const double y = p.y[s] + (p.y[s + 1] - p.y[s]) * (pct - p.x[s]) / (p.x[s + 1] - p.x[s]);
+        const int32_t out = c.apply(v);
+        maxErr = max(maxErr, abs(out - (int32_t)lround(y * scale / 100)));
+        if (out < prev) monotonic = false;
+        prev = out;
+    }
+    CHECK(maxErr <= 3); // Índice en Q16 truncado + interpolación: < 0.01 % del fondo
+    CHECK(monotonic);
+    CHECK_EQ(c.apply(0), 0);
+    CHECK_EQ(c.apply(scale), scale);
+    CHECK_NEAR(c.apply(scale / 2), scale / 2, 1);
+}
+
+static void testFlatEnds() {
+    // Antes del primer punto y después del último la salida se mantiene
+    ResponseCurve c;
+    CHECK(c.compile(points({20, 80}, {10, 90}), 1000));
+    CHECK_EQ(c.apply(0), 100);
+    CHECK_EQ(c.apply(150), 100);
+    CHECK_EQ(c.apply(900), 900);
+    CHECK_EQ(c.apply(1000), 900);
+    CHECK_EQ(c.apply(-5), 100);  // Fuera de rango se recorta
+    CHECK_EQ(c.apply(2000), 900);
+    CHECK_NEAR(c.apply(500), 500, 1);
+}
+
+int main() {
+    testValidation();
+    testLinearIsIdentity();
+    testInvalidFallsBackToLinear();
+    testPiecewise();
+    testFlatEnds();
+    return testResult("ResponseCurve");
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_sample_ring.cpp
+ * @brief Pruebas de SampleRing: orden FIFO, cola llena y paso entre dos hilos.
+ */
+#include "test.h"
+#include "SampleRing.h"
+#include <thread>
+
+static void testFifo() {
+    SampleRing<LoadCellSample, 4> ring;
+    LoadCellSample s;
+    CHECK(!ring.pop(s));
+    CHECK_EQ(ring.available(), 0);
+
+    for (uint32_t i = 0; i < 3; i++) CHECK(ring.push({(int32_t)i * 10, i, i * 100}));
+    CHECK_EQ(ring.available(), 3);
+    for (uint32_t i = 0; i < 3; i++) {
+        CHECK(ring.pop(s));
+        CHECK_EQ(s.value, (int32_t)i * 10);
+        CHECK_EQ(s.seq, i);
+        CHECK_EQ(s.micros, i * 100);
+    }
+    CHECK(!ring.pop(s));
+}
+
+static void testFullDropsNewest() {
+    SampleRing<LoadCellSample, 4> ring;
+    for (uint32_t i = 0; i < 4; i++) CHECK(ring.push({(int32_t)i, i, 0}));
+    CHECK(!ring.push({99, 99, 0}));
+    CHECK(!ring.push({98, 98, 0}));
+    CHECK_EQ(ring.dropped(), 2);
+
+    // Las cuatro primeras siguen ahí, en orden; las rechazadas no aparecen
+    LoadCellSample s;
+    for (uint32_t i = 0; i < 4; i++) {
+        CHECK(ring.pop(s));
+        CHECK_EQ(s.seq, i);
+    }
+    CHECK(!ring.pop(s));
+    CHECK(ring.push({4, 4, 0})); // Tras vaciarla vuelve a aceptar
+}
+
+static void testIndexWrap() {
+    // Muchas vueltas al buffer: los índices crecen sin límite y se enmascaran
+    SampleRing<LoadCellSample, 2> ring;
+    LoadCellSample s;
+    bool ok = true;
+    for (uint32_t i = 0; i < 100000; i++) {
+        ok &= ring.push({(int32_t)i, i, 0});
+        ok &= ring.pop(s) && s.seq == i;
+    }
+    CHECK(ok);
+    CHECK_EQ(ring.dropped(), 0);
+}
+
+static void testTwoThreads() {
+    // Productor y consumidor concurrentes: todo lo aceptado llega una vez y en orden
+    static SampleRing<LoadCellSample, 16> ring;
+    constexpr uint32_t COUNT = 200000;
+    uint32_t pushed = 0;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            if (ring.push({(int32_t)(i * 3), i, i})) pushed++;
+        }
+    });
+
+    uint32_t received = 0, lastSeq = 0;
+    bool ordered = true, intact = true;
+    LoadCellSample s;
+    while (true) {
+        if (ring.pop(s)) {
+            if (received && s.seq <= lastSeq) ordered = false;
+            if (s.value != (int32_t)(s.seq * 3) || s.micros != s.seq) intact = false;
+            lastSeq = s.seq;
+            received++;
+        } else if (ring.dropped() + received == COUNT) {
+            break;
+        }
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK(intact);
+    CHECK_EQ(received, pushed);
+    CHECK_EQ(received + ring.dropped(), COUNT);
+}
+
+int main() {
+    testFifo();
+    testFullDropsNewest();
+    testIndexWrap();
+    testTwoThreads();
+    return testResult("SampleRing");
+}
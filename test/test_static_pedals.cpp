@@ -0,0 +1,89 @@
+/**
+ * @file test_static_pedals.cpp
+ * @brief Pruebas de StaticPedals: mismo comportamiento que ThreePedals sin la base Pedals.
+ */
+#include "test.h"
+#include "SimRacing.h"
+
+using namespace SimRacing;
+
+static constexpr PinNum PIN_GAS = 1, PIN_BRAKE = 2, PIN_CLUTCH = 3;
+
+// Estáticos como los globales del sketch: Peripheral no inicializa su puntero al detector
+static ThreePedals reference(PIN_GAS, PIN_BRAKE, PIN_CLUTCH);
+static StaticPedals<PIN_GAS, PIN_BRAKE, PIN_CLUTCH> pedals;
+
+static void setPins(uint32_t i) {
+    hostAnalogValues[PIN_GAS] = (int)(i * 7 & 4095);
+    hostAnalogValues[PIN_BRAKE] = (int)(i * 11 & 4095);
+    hostAnalogValues[PIN_CLUTCH] = (int)((i / 3) * 13 & 4095);
+}
+
+static void testCompileTimeShape() {
+    static_assert(StaticPedals<PIN_GAS, PIN_BRAKE, PIN_CLUTCH>::NumPedals == 3, "tres pedales");
+    static_assert(StaticPedals<PIN_GAS>::getNumPedals() == 1, "un pedal");
+    static_assert(StaticPedals<PIN_GAS, PIN_BRAKE>::hasPedal(Brake), "freno presente");
+    static_assert(!StaticPedals<PIN_GAS, PIN_BRAKE>::hasPedal(Clutch), "sin embrague");
+    CHECK(true);
+}
+
+static void testMatchesThreePedals() {
+    const AnalogInput::Calibration gas = {300, 3800}, brake = {0, 4095}, clutch = {3900, 200};
+    reference.setCalibration(gas, brake, clutch);
+    pedals.setCalibration(gas, brake, clutch);
+    reference.begin();
+    pedals.begin();
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < 10000; i++) {
+        setPins(i);
+        if (reference.update() != pedals.update()) mismatches++;
+        if (reference.positionChanged() != pedals.positionChanged()) mismatches++;
+        for (const Pedal id : {Gas, Brake, Clutch}) {
+            if (reference.getPositionRaw(id) != pedals.getPositionRaw(id)) mismatches++;
+            if (reference.getPosition(id, 0, 16383) != pedals.getPosition(id, 0, 16383)) mismatches++;
+            if (reference.getPosition(id) != pedals.getPosition(id)) mismatches++;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+static void testUnchangedInputReportsNoChange() {
+    setPins(5);
+    pedals.update();
+    CHECK(!pedals.update());
+    CHECK(!pedals.positionChanged());
+    hostAnalogValues[PIN_BRAKE] += 100; // El gas sigue bajo su mínimo calibrado: no contaría como cambio
+    CHECK(pedals.update());
+}
+
+static void testMissingPedal() {
+    // Como Pedals: un pedal que no existe devuelve rMin / Min / 0 y se ignora al configurarlo
+    static StaticPedals<PIN_GAS> single;
+    single.setCalibration(Clutch, {0, 10});
+    CHECK_EQ(single.getPosition(Clutch, 7, 100), 7);
+    CHECK_EQ(single.getPositionRaw(Clutch), AnalogInput::Min);
+    CHECK_EQ(single.getResolution(Clutch), 0);
+    CHECK_EQ(single.getSpikeCount(Clutch), 0);
+}
+
+static void testSpikeRejection() {
+    pedals.setSpikeRejection(Gas, 200);
+    const int in[] = {1000, 1000, 1000, 4000, 1000, 1000};
+    for (int x : in) {
+        hostAnalogValues[PIN_GAS] = x;
+        pedals.update();
+        CHECK_EQ(pedals.getPositionRaw(Gas), 1000);
+    }
+    CHECK_EQ(pedals.getSpikeCount(Gas), 1);
+    pedals.setSpikeRejection(Gas, 0);
+}
+
+int main() {
+    testCompileTimeShape();
+    testMatchesThreePedals();
+    testUnchangedInputReportsNoChange();
+    testMissingPedal();
+    testSpikeRejection();
+    return testResult("StaticPedals");
+}
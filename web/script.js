@@ -13,6 +13,10 @@ const SERVICE_UUID = "6E400001-B5A3-F393-E0A9-E50E24DCCA9E";
 const RX_UUID = "6E400002-B5A3-F393-E0A9-E50E24DCCA9E"; // Mobile writes
 const TX_UUID = "6E400003-B5A3-F393-E0A9-E50E24DCCA9E"; // Mobile receives
 
+// Fondo de escala de gas/embrague; se actualiza con la resolución del ADC ("res" en cal)
+let analogMax = 4095;
+const BRAKE_MAX = 16384;
+
 // UI Elements
 const connectSerialBtn = document.getElementById("connectSerialBtn");
 const connectBleBtn = document.getElementById("connectBleBtn");
@@ -55,6 +59,9 @@ const rawC = document.getElementById("raw-c");
 const filterRange = document.getElementById("filterRange");
 const filterVal = document.getElementById("filterVal");
 
+const curvePedal = document.getElementById("curvePedal");
+const curveApplyBtn = document.getElementById("curveApplyBtn");
+
 // --- Signal Monitor Class ---
 class SignalMonitor {
   constructor(canvasId) {
@@ -89,10 +96,10 @@ class SignalMonitor {
     if (!this.running) return;
 
     // Normalizar a 0-1 usando el rango de salida del Joystick
-    // Gas/Clutch (4095), Brake (16384)
-    this.data.g.push(Math.min(1, Math.max(0, g / 4095)));
-    this.data.b.push(Math.min(1, Math.max(0, b / 16384)));
-    this.data.c.push(Math.min(1, Math.max(0, c / 4095)));
+    // Gas/Clutch (analogMax), Brake (BRAKE_MAX)
+    this.data.g.push(Math.min(1, Math.max(0, g / analogMax)));
+    this.data.b.push(Math.min(1, Math.max(0, b / BRAKE_MAX)));
+    this.data.c.push(Math.min(1, Math.max(0, c / analogMax)));
 
     if (this.data.g.length > this.maxPoints) this.data.g.shift();
     if (this.data.b.length > this.maxPoints) this.data.b.shift();
@@ -180,6 +187,210 @@ if (document.getElementById("signalChart")) {
   monitor = new SignalMonitor("signalChart");
 }
 
+// --- Response Curve Editor ---
+// Puntos en % (0-100) como los guarda el firmware: {x: [...], y: [...]}
+class CurveEditor {
+  constructor(canvasId) {
+    this.canvas = document.getElementById(canvasId);
+    this.ctx = this.canvas.getContext("2d");
+    this.maxPoints = 8;
+    this.curves = {
+      g: { x: [0, 100], y: [0, 100] },
+      b: { x: [0, 100], y: [0, 100] },
+      c: { x: [0, 100], y: [0, 100] },
+    };
+    this.pedal = "g";
+    this.live = { g: null, b: null, c: null }; // {input}: recorrido previo a la curva, 0-1
+    this.dragging = -1;
+
+    this.canvas.addEventListener("mousedown", (e) => this.onDown(e));
+    this.canvas.addEventListener("mousemove", (e) => this.onMove(e));
+    window.addEventListener("mouseup", () => (this.dragging = -1));
+    this.canvas.addEventListener("dblclick", (e) => this.onRemove(e));
+    this.draw = this.draw.bind(this);
+    requestAnimationFrame(this.draw);
+  }
+
+  get points() {
+    return this.curves[this.pedal];
+  }
+
+  setCurve(pedal, x, y) {
+    if (!this.curves[pedal] || x.length !== y.length) return;
+    this.curves[pedal] = { x: x.slice(), y: y.slice() };
+  }
+
+  setPreset(name) {
+    const presets = {
+      linear: { x: [0, 100], y: [0, 100] },
+      progressive: { x: [0, 25, 50, 75, 100], y: [0, 8, 25, 55, 100] },
+      scurve: { x: [0, 25, 50, 75, 100], y: [0, 12, 50, 88, 100] },
+    };
+    if (presets[name]) this.setCurve(this.pedal, presets[name].x, presets[name].y);
+  }
+
+  // Misma interpolación por tramos que ResponseCurve en el firmware
+  evaluate(curve, xPct) {
+    const { x, y } = curve;
+    if (xPct <= x[0]) return y[0];
+    for (let i = 0; i < x.length - 1; i++) {
+      if (xPct <= x[i + 1]) {
+        return y[i] + ((y[i + 1] - y[i]) * (xPct - x[i])) / (x[i + 1] - x[i]);
+      }
+    }
+    return y[y.length - 1];
+  }
+
+  toCanvas(px, py) {
+    return [(px / 100) * this.canvas.width, this.canvas.height - (py / 100) * this.canvas.height];
+  }
+
+  fromEvent(e) {
+    const rect = this.canvas.getBoundingClientRect();
+    const px = Math.round(((e.clientX - rect.left) / rect.width) * 100);
+    const py = Math.round((1 - (e.clientY - rect.top) / rect.height) * 100);
+    return [Math.min(100, Math.max(0, px)), Math.min(100, Math.max(0, py))];
+  }
+
+  hit(e) {
+    const [px, py] = this.fromEvent(e);
+    const { x, y } = this.points;
+    for (let i = 0; i < x.length; i++) {
+      if (Math.abs(x[i] - px) <= 3 && Math.abs(y[i] - py) <= 5) return i;
+    }
+    return -1;
+  }
+
+  onDown(e) {
+    const i = this.hit(e);
+    if (i >= 0) {
+      this.dragging = i;
+      return;
+    }
+    const { x, y } = this.points;
+    if (x.length >= this.maxPoints) return;
+    const [px, py] = this.fromEvent(e);
+    if (x.includes(px)) return;
+    let at = x.findIndex((v) => v > px);
+    if (at < 0) at = x.length;
+    x.splice(at, 0, px);
+    y.splice(at, 0, py);
+    this.dragging = at;
+  }
+
+  onMove(e) {
+    if (this.dragging < 0) return;
+    const [px, py] = this.fromEvent(e);
+    const { x, y } = this.points;
+    const i = this.dragging;
+    // x estrictamente creciente, como exige el firmware
+    const lo = i > 0 ? x[i - 1] + 1 : 0;
+    const hi = i < x.length - 1 ? x[i + 1] - 1 : 100;
+    x[i] = Math.min(hi, Math.max(lo, px));
+    y[i] = py;
+  }
+
+  onRemove(e) {
+    const i = this.hit(e);
+    const { x, y } = this.points;
+    if (i < 0 || x.length <= 2) return;
+    x.splice(i, 1);
+    y.splice(i, 1);
+  }
+
+  toCommand() {
+    const { x, y } = this.points;
+    return JSON.stringify({ curve: { p: this.pedal, x: x, y: y } });
+  }
+
+  draw() {
+    const ctx = this.ctx;
+    if (this.canvas.width !== this.canvas.offsetWidth) {
+      this.canvas.width = this.canvas.offsetWidth;
+      this.canvas.height = this.canvas.offsetHeight || 200;
+    }
+    const w = this.canvas.width;
+    const h = this.canvas.height;
+    const color =
+      getComputedStyle(document.documentElement)
+        .getPropertyValue(this.pedal === "g" ? "--primary" : this.pedal === "b" ? "--brake" : "--clutch")
+        .trim() || "#00e676";
+
+    ctx.clearRect(0, 0, w, h);
+
+    // Rejilla y diagonal de referencia
+    ctx.strokeStyle = "rgba(255, 255, 255, 0.08)";
+    ctx.lineWidth = 1;
+    for (let i = 1; i < 4; i++) {
+      ctx.beginPath();
+      ctx.moveTo((w * i) / 4, 0);
+      ctx.lineTo((w * i) / 4, h);
+      ctx.moveTo(0, (h * i) / 4);
+      ctx.lineTo(w, (h * i) / 4);
+      ctx.stroke();
+    }
+    ctx.setLineDash([4, 4]);
+    ctx.beginPath();
+    ctx.moveTo(0, h);
+    ctx.lineTo(w, 0);
+    ctx.stroke();
+    ctx.setLineDash([]);
+
+    // Curva
+    const curve = this.points;
+    ctx.strokeStyle = color;
+    ctx.lineWidth = 2;
+    ctx.beginPath();
+    for (let px = 0; px <= 100; px++) {
+      const [cx, cy] = this.toCanvas(px, this.evaluate(curve, px));
+      if (px === 0) ctx.moveTo(cx, cy);
+      else ctx.lineTo(cx, cy);
+    }
+    ctx.stroke();
+
+    // Puntos de control
+    ctx.fillStyle = color;
+    for (let i = 0; i < curve.x.length; i++) {
+      const [cx, cy] = this.toCanvas(curve.x[i], curve.y[i]);
+      ctx.beginPath();
+      ctx.arc(cx, cy, 5, 0, 2 * Math.PI);
+      ctx.fill();
+    }
+
+    // Señal en vivo: recorrido lineal y salida con la curva aplicada
+    const live = this.live[this.pedal];
+    if (live) {
+      const xPct = live.input * 100;
+      const [lx] = this.toCanvas(xPct, 0);
+      ctx.strokeStyle = "rgba(255, 255, 255, 0.4)";
+      ctx.beginPath();
+      ctx.moveTo(lx, 0);
+      ctx.lineTo(lx, h);
+      ctx.stroke();
+
+      const [px, py] = this.toCanvas(xPct, this.evaluate(curve, xPct));
+      ctx.fillStyle = "#ffffff";
+      ctx.beginPath();
+      ctx.arc(px, py, 4, 0, 2 * Math.PI);
+      ctx.fill();
+    }
+
+    requestAnimationFrame(this.draw);
+  }
+}
+
+let curveEditor;
+if (document.getElementById("curveCanvas")) {
+  curveEditor = new CurveEditor("curveCanvas");
+}
+let lastCal = null; // Última calibración recibida, para situar la señal en vivo sobre la curva
+
+// Recorrido lineal 0-1 desde el valor crudo y la calibración (min > max = eje invertido)
+function travel(raw, min, max) {
+  if (max === min) return 0;
+  return Math.min(1, Math.max(0, (raw - min) / (max - min)));
+}
+
 // --- Connection Logic (Serial) ---
 
 async function connectSerial() {
@@ -334,17 +545,17 @@ function setUIEnabled(enabled) {
 function updateUI(data) {
   // Update Bars
   if (data.g !== undefined) {
-    const gasPct = (data.g / 4095) * 100;
+    const gasPct = (data.g / analogMax) * 100;
     gasBar.style.width = `${gasPct}%`;
     gasVal.innerText = `${Math.round(gasPct)}%`;
   }
   if (data.b !== undefined) {
-    const brakePct = (data.b / 16384) * 100;
+    const brakePct = (data.b / BRAKE_MAX) * 100;
     brakeBar.style.width = `${brakePct}%`;
     brakeVal.innerText = `${Math.round(brakePct)}%`;
   }
   if (data.c !== undefined) {
-    const clutchPct = (data.c / 4095) * 100;
+    const clutchPct = (data.c / analogMax) * 100;
     clutchBar.style.width = `${clutchPct}%`;
     clutchVal.innerText = `${Math.round(clutchPct)}%`;
   }
@@ -355,20 +566,44 @@ function updateUI(data) {
     if (rawB) rawB.innerText = data.rb ? data.rb.toFixed(0) : 0;
     if (rawC) rawC.innerText = data.rc;
 
-    // Push to Monitor (CALIBRATED Values 0-4095)
+    // Recorrido previo a la curva para la vista previa del editor
+    if (curveEditor && lastCal) {
+      curveEditor.live.g = { input: travel(data.rg, lastCal.gmin, lastCal.gmax) };
+      curveEditor.live.b = { input: lastCal.bmax > 0 ? travel(data.rb, 0, lastCal.bmax) : 0 };
+      curveEditor.live.c = { input: travel(data.rc, lastCal.cmin, lastCal.cmax) };
+    }
+
+    // Push to Monitor (CALIBRATED Values 0-analogMax)
     // Usamos los valores finales 'data.g', 'data.b', 'data.c' para ver la respuesta real
     if (monitor && data.g !== undefined) {
       monitor.push(data.g, data.b, data.c);
     }
   }
 
+  // Diagnostics counters
+  if (data.diag) {
+    appendLog(
+      "Diag: " +
+        Object.entries(data.diag)
+          .map(([k, v]) => `${k}=${v}`)
+          .join(" ")
+    );
+  }
+
   // Update Calibration Data
+  // Curva de respuesta de un pedal (llega tras "cal" y al aplicar una curva)
+  if (data.curve && curveEditor) {
+    curveEditor.setCurve(data.curve.p, data.curve.x, data.curve.y);
+  }
+
   if (data.cal) {
+    lastCal = data.cal;
+    if (data.cal.res) analogMax = (1 << data.cal.res) - 1;
     gMin.innerText = data.cal.gmin;
     gMax.innerText = data.cal.gmax;
     bMax.innerText = data.cal.bmax.toFixed(0);
     if (data.cal.bmax > 0)
-      bScale.innerText = (16384 / data.cal.bmax).toFixed(4);
+      bScale.innerText = (BRAKE_MAX / data.cal.bmax).toFixed(4);
     cMin.innerText = data.cal.cmin;
     cMax.innerText = data.cal.cmax;
 
@@ -378,7 +613,7 @@ function updateUI(data) {
     // Update Filter UI
     if (data.cal.filter !== undefined) {
       if (filterRange) filterRange.value = data.cal.filter;
-      if (filterVal) filterVal.innerText = data.cal.filter + "%";
+      if (filterVal) filterVal.innerText = formatCutoff(data.cal.filter);
     }
   }
 }
@@ -514,8 +749,9 @@ window.addEventListener("keydown", (e) => {
   }
 });
 
-diagBtn.addEventListener("click", () => {
-  sendCommand("d");
+diagBtn.addEventListener("click", async () => {
+  await sendCommand("d");
+  await sendCommand("q"); // Contadores en JSON (también llegan por BLE)
   appendLog("Requesting hardware diagnostics...");
 });
 
@@ -523,10 +759,15 @@ advancedToggle.addEventListener("click", () => {
   advancedSection.classList.toggle("visible");
 });
 
+// Filter cutoff in Hz; 0 disables the filter
+function formatCutoff(hz) {
+  return Number(hz) === 0 ? "Off" : hz + " Hz";
+}
+
 if (filterRange) {
   filterRange.addEventListener("input", (e) => {
     const val = e.target.value;
-    if (filterVal) filterVal.innerText = val + "%";
+    if (filterVal) filterVal.innerText = formatCutoff(val);
     sendCommand("f" + val); // Real-time update
   });
 
@@ -536,3 +777,23 @@ if (filterRange) {
     appendLog("Filter setting saved.");
   });
 }
+
+if (curveEditor) {
+  if (curvePedal) {
+    curvePedal.addEventListener("change", (e) => {
+      curveEditor.pedal = e.target.value;
+    });
+  }
+
+  document.querySelectorAll(".curve-preset").forEach((btn) => {
+    btn.addEventListener("click", () => curveEditor.setPreset(btn.dataset.preset));
+  });
+
+  if (curveApplyBtn) {
+    curveApplyBtn.addEventListener("click", async () => {
+      await sendCommand(curveEditor.toCommand());
+      await sendCommand("s"); // Guardar en flash, igual que el filtro
+      appendLog("Response curve applied and saved.");
+    });
+  }
+}